@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+#include "concurrent_ilist.h"
+
+namespace {
+
+// A 64 entries subscriber set scanned by every thread: lock-free readers against
+// readers taking the list mutex
+constexpr int n_entries = 64;
+
+struct C final: br::concurrent_ilist<C>::node {
+    int value{1};
+};
+
+struct L final: br::ilist<L>::node {
+    int value{1};
+};
+
+br::epoch_domain        domain;
+br::concurrent_ilist<C> c_list(domain);
+std::vector<C>          c_entries(n_entries);
+
+std::mutex     l_lock;
+br::ilist<L>   l_list;
+std::vector<L> l_entries(n_entries);
+
+void BM_ConcurrentIList_Scan(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        for (auto& e : c_entries) c_list.push_back(&e);
+    }
+
+    for (auto _ : state) {
+        int sum = 0;
+        c_list.for_each([&](const C& e) { sum += e.value; });
+        benchmark::DoNotOptimize(sum);
+    }
+
+    if (state.thread_index() == 0) {
+        for (auto& e : c_entries) c_list.erase(&e);
+        domain.synchronize();
+    }
+}
+
+void BM_LockedIList_Scan(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        for (auto& e : l_entries) l_list.push_back(&e);
+    }
+
+    for (auto _ : state) {
+        int sum = 0;
+        {
+            std::lock_guard l(l_lock);
+            for (auto& e : l_list) sum += e.value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    if (state.thread_index() == 0) {
+        for (auto& e : l_entries) e.unlink();
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_ConcurrentIList_Scan)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_LockedIList_Scan)->ThreadRange(1, 8)->UseRealTime();
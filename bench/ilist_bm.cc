@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <vector>
+
+#include "ilist.h"
+#include "islist.h"
+
+namespace {
+
+// Moving a batch of objects between two locked lists, one lock per object against
+// one lock per batch
+struct K final: br::ilist<K, std::mutex>::node {};
+using LW = br::ilist<K, std::mutex>;
+
+void BM_IList_PushPop(benchmark::State& state)
+{
+    std::vector<K> v(state.range(0));
+    LW             in;
+    LW             out;
+    for (auto& k : v) in.push_back(&k);
+
+    for (auto _ : state) {
+        while (auto* k = in.pop_front()) out.push_back(k);
+        while (auto* k = out.pop_front()) in.push_back(k);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+    in.clear();
+}
+
+void BM_IList_Splice(benchmark::State& state)
+{
+    std::vector<K>  v(state.range(0));
+    std::vector<K*> p;
+    for (auto& k : v) p.push_back(&k);
+
+    LW in;
+    LW out;
+    in.push_back_batch(p.begin(), p.end());
+
+    for (auto _ : state) {
+        in.drain_to(out);
+        out.drain_to(in);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+    in.clear();
+}
+
+// A free list: take an object, give it back, over a pool larger than the caches
+template <typename LIST, typename T>
+void run_free_list(benchmark::State& state)
+{
+    std::vector<T> pool(state.range(0));
+    LIST           free;
+    for (auto& e : pool) free.push_front(&e);
+
+    for (auto _ : state) {
+        auto* a = free.pop_front();
+        auto* b = free.pop_front();
+        free.push_back(a);
+        free.push_back(b);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    free.clear();
+}
+
+struct D final: br::ilist<D>::node {};
+struct S final: br::islist<S>::node {};
+
+void BM_IList_FreeList(benchmark::State& state)
+{
+    run_free_list<br::ilist<D>, D>(state);
+}
+
+void BM_ISList_FreeList(benchmark::State& state)
+{
+    run_free_list<br::islist<S>, S>(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_IList_FreeList)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ISList_FreeList)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_IList_PushPop)->Range(64, 4096);
+BENCHMARK(BM_IList_Splice)->Range(64, 4096);
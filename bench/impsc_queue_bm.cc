@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ilist.h"
+#include "impsc_queue.h"
+#include "istack.h"
+#include "spinlock.h"
+
+namespace {
+
+// Producers hand over items_per_producer objects each to the benchmark thread, which
+// pops them all. Reported items per second are objects handed over.
+constexpr std::size_t items_per_producer = 1 << 16;
+
+struct Q final: br::impsc_queue<Q>::node {};
+struct S final: br::istack<S>::node {};
+struct LM final: br::ilist<LM, std::mutex>::node {};
+struct LS final: br::ilist<LS, br::spinlock>::node {};
+
+template <typename T, typename QUEUE, typename PUSH, typename POP>
+void run_handoff(benchmark::State& state, PUSH push, POP pop)
+{
+    const auto     n_producers = static_cast<std::size_t>(state.range(0));
+    std::vector<T> items(n_producers * items_per_producer);
+
+    for (auto _ : state) {
+        QUEUE q;
+        {
+            std::vector<std::jthread> producers;
+            for (std::size_t p = 0; p < n_producers; ++p) {
+                producers.emplace_back([&, p]() {
+                    for (std::size_t i = p * items_per_producer; i < (p + 1) * items_per_producer; ++i) {
+                        push(q, &items[i]);
+                    }
+                });
+            }
+
+            for (std::size_t received = 0; received < items.size();) {
+                received += pop(q);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+void BM_IMpscQueue(benchmark::State& state)
+{
+    run_handoff<Q, br::impsc_queue<Q>>(
+        state, [](auto& q, Q* e) { q.push(e); }, [](auto& q) { return q.pop() ? 1 : 0; });
+}
+
+void BM_IStack(benchmark::State& state)
+{
+    run_handoff<S, br::istack<S>>(
+        state,
+        [](auto& q, S* e) { q.push(e); },
+        [](auto& q) {
+            std::size_t n = 0;
+            for (auto* e = q.pop_all(); e; e = e->next()) ++n;
+            return n;
+        });
+}
+
+void BM_IList_Mutex(benchmark::State& state)
+{
+    run_handoff<LM, br::ilist<LM, std::mutex>>(
+        state, [](auto& q, LM* e) { q.push_back(e); }, [](auto& q) { return q.pop_front() ? 1 : 0; });
+}
+
+void BM_IList_Spinlock(benchmark::State& state)
+{
+    run_handoff<LS, br::ilist<LS, br::spinlock>>(
+        state, [](auto& q, LS* e) { q.push_back(e); }, [](auto& q) { return q.pop_front() ? 1 : 0; });
+}
+
+} // namespace
+
+BENCHMARK(BM_IMpscQueue)->DenseRange(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IStack)->DenseRange(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IList_Mutex)->DenseRange(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IList_Spinlock)->DenseRange(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+#include "cohort_lock.h"
+#include "fair_lock.h"
+#include "profiled_lock.h"
+#include "spinlock.h"
+
+namespace {
+
+// Every thread increments a shared counter under the lock, with some private work
+// between critical sections so the lock is not held back to back
+template <typename LOCK>
+struct contended {
+    alignas(64) LOCK lock;
+    long counter{0};
+};
+
+template <typename LOCK>
+void run_contention(benchmark::State& state)
+{
+    static contended<LOCK> c;
+
+    for (auto _ : state) {
+        {
+            std::lock_guard g(c.lock);
+            c.counter = c.counter + 1;
+        }
+        for (int i = 0; i < state.range(0); ++i) benchmark::DoNotOptimize(i);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StdMutex(benchmark::State& state)
+{
+    run_contention<std::mutex>(state);
+}
+
+void BM_Spinlock(benchmark::State& state)
+{
+    run_contention<br::spinlock>(state);
+}
+
+void BM_AdaptiveMutex(benchmark::State& state)
+{
+    run_contention<br::adaptive_mutex>(state);
+}
+
+void BM_TicketLock(benchmark::State& state)
+{
+    run_contention<br::ticket_lock>(state);
+}
+
+void BM_McsLock(benchmark::State& state)
+{
+    run_contention<br::mcs_lock>(state);
+}
+
+void BM_CohortLock(benchmark::State& state)
+{
+    run_contention<br::cohort_lock<>>(state);
+}
+
+// Cost of the profiling wrapper
+void BM_ProfiledSpinlock(benchmark::State& state)
+{
+    run_contention<br::basic_profiled_lock<br::spinlock>>(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_StdMutex)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_Spinlock)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_AdaptiveMutex)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_TicketLock)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_McsLock)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_CohortLock)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_ProfiledSpinlock)->Arg(0)->Arg(100)->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "lru_cache.h"
+
+namespace {
+
+// Zipf-like lookups of 1M keys over a cache of 64K entries, inserting on misses
+constexpr std::size_t capacity = 1 << 16;
+constexpr int         n_keys   = 1 << 20;
+
+std::vector<int> workload()
+{
+    std::mt19937                    gen(1337);
+    std::exponential_distribution<> dist(1.0 / capacity);
+    std::vector<int>                keys(1 << 20);
+    for (auto& k : keys) k = static_cast<int>(dist(gen)) % n_keys;
+    return keys;
+}
+
+struct E final: br::lru_cache<E, int>::node {};
+
+void BM_LruCache(benchmark::State& state)
+{
+    const auto keys = workload();
+
+    // One more than the capacity, so there is always a free entry to insert
+    std::vector<E>        pool(capacity + 1);
+    std::vector<E*>       free;
+    br::lru_cache<E, int> c(capacity);
+    for (auto& e : pool) free.push_back(&e);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto k = keys[i++ & (keys.size() - 1)];
+        if (!c.find(k)) {
+            auto* e = free.back();
+            free.pop_back();
+            if (auto* out = c.insert(k, e)) free.push_back(out);
+        }
+    }
+}
+
+// The hand-rolled version: an ilist for recency and an unordered_map for the index
+struct M final: br::ilist<M>::node {
+    int key;
+};
+
+void BM_MapIListCache(benchmark::State& state)
+{
+    const auto keys = workload();
+
+    br::ilist<M>                recency;
+    std::unordered_map<int, M*> index;
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto k  = keys[i++ & (keys.size() - 1)];
+        const auto it = index.find(k);
+        if (it != index.end()) {
+            it->second->unlink();
+            recency.push_front(it->second);
+            continue;
+        }
+
+        M* e;
+        if (index.size() == capacity) {
+            e = recency.pop_back();
+            index.erase(e->key);
+            delete e;
+        }
+        e      = new M;
+        e->key = k;
+        recency.push_front(e);
+        index.emplace(k, e);
+    }
+
+    while (auto* e = recency.pop_front()) delete e;
+}
+
+} // namespace
+
+BENCHMARK(BM_LruCache);
+BENCHMARK(BM_MapIListCache);
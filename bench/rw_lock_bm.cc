@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "arch_info.h"
+#include "rw_spinlock.h"
+#include "seqlock.h"
+#include "spinlock.h"
+
+namespace {
+
+// Every core arch_info knows about, or what the standard library reports
+int n_cpus()
+{
+    const br::arch_info ai;
+    std::size_t         n = 0;
+    if (ai.info_ready()) {
+        for (const auto& node : ai.numa_nodes()) n += node.cpus().size();
+    }
+    return static_cast<int>(n ? n : std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// A small routing table read by every thread, never written during the run
+struct table {
+    long routes[8]{1, 2, 3, 4, 5, 6, 7, 8};
+};
+
+long read(const table& t)
+{
+    long sum = 0;
+    for (const auto r : t.routes) sum += r;
+    return sum;
+}
+
+template <typename LOCK, typename GUARD>
+void run_readers(benchmark::State& state)
+{
+    static LOCK  l;
+    static table t;
+
+    for (auto _ : state) {
+        GUARD g(l);
+        benchmark::DoNotOptimize(read(t));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Readers_Spinlock(benchmark::State& state)
+{
+    run_readers<br::spinlock, std::lock_guard<br::spinlock>>(state);
+}
+
+void BM_Readers_SharedMutex(benchmark::State& state)
+{
+    run_readers<std::shared_mutex, std::shared_lock<std::shared_mutex>>(state);
+}
+
+void BM_Readers_RwSpinlock(benchmark::State& state)
+{
+    run_readers<br::rw_spinlock, std::shared_lock<br::rw_spinlock>>(state);
+}
+
+void BM_Readers_Seqlock(benchmark::State& state)
+{
+    static br::seqlock<table> s;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(s.load()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_Readers_Spinlock)->ThreadRange(1, n_cpus())->UseRealTime();
+BENCHMARK(BM_Readers_SharedMutex)->ThreadRange(1, n_cpus())->UseRealTime();
+BENCHMARK(BM_Readers_RwSpinlock)->ThreadRange(1, n_cpus())->UseRealTime();
+BENCHMARK(BM_Readers_Seqlock)->ThreadRange(1, n_cpus())->UseRealTime();
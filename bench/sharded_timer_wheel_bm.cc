@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include "sharded_timer_wheel.h"
+
+namespace {
+
+constexpr std::size_t max_threads = 32;
+constexpr std::size_t pool_size   = 1 << 14;
+
+template <typename E>
+std::vector<E>& pool(std::size_t thread)
+{
+    static std::vector<std::vector<E>> pools(max_threads, std::vector<E>(pool_size));
+    return pools[thread];
+}
+
+struct TS final: br::ts_expirable {
+    void expire() override { benchmark::DoNotOptimize(this); }
+};
+
+struct T final: br::expirable {
+    void expire() override { benchmark::DoNotOptimize(this); }
+};
+
+// Every publisher thread (re)publishes its own timers to a shared locked wheel
+void BM_TsTimerWheel_Publish(benchmark::State& state)
+{
+    static br::ts_timer_wheel tw(std::chrono::seconds(1), 4096, std::chrono::steady_clock::now());
+
+    auto&       p = pool<TS>(state.thread_index());
+    const auto  t = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        tw.reschedule(&p[i & (pool_size - 1)], t + std::chrono::seconds(i & 1023));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Same through the inboxes of a wheel per CPU, publisher threads spread over the shards
+void BM_ShardedTimerWheel_Publish(benchmark::State& state)
+{
+    static br::sharded_timer_wheel stw(std::chrono::seconds(1), 4096);
+
+    auto&       p     = pool<T>(state.thread_index());
+    const auto  shard = state.thread_index() % stw.size();
+    const auto  t     = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    std::size_t i     = 0;
+    for (auto _ : state) {
+        while (!stw.publish(shard, &p[i & (pool_size - 1)], t + std::chrono::seconds(i & 1023))) {
+            std::this_thread::yield();
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_TsTimerWheel_Publish)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(BM_ShardedTimerWheel_Publish)->ThreadRange(1, max_threads)->UseRealTime();
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "slab_timer_wheel.h"
+
+namespace {
+
+// 1M+ pending timers with deadlines up to an hour away on a 256 slots wheel, so every
+// tick visits ~N/256 timers of which only ~1/14 are due. Expired timers are published
+// again, keeping the number of pending timers steady.
+constexpr std::size_t n_slots = 256;
+constexpr int         horizon = 3600;
+
+struct R final: br::expirable {
+    std::vector<R*>* expired{nullptr};
+
+    void expire() override { expired->push_back(this); }
+};
+
+void BM_TimerWheel_Tick(benchmark::State& state)
+{
+    const auto                      n = static_cast<std::size_t>(state.range(0));
+    std::mt19937                    gen(1337);
+    std::uniform_int_distribution<> dist(1, horizon);
+
+    std::vector<R*>                 expired;
+    std::vector<std::unique_ptr<R>> timers(n);
+    for (auto& r : timers) {
+        r          = std::make_unique<R>();
+        r->expired = &expired;
+    }
+    // Slot lists jump around the heap, as they do when timers are created over time
+    std::shuffle(timers.begin(), timers.end(), gen);
+
+    br::time_point  now;
+    br::timer_wheel tw(std::chrono::seconds(1), n_slots, now);
+    for (auto& r : timers) tw.publish(r.get(), now + std::chrono::seconds(dist(gen)));
+
+    for (auto _ : state) {
+        now += std::chrono::seconds(1);
+        tw.check_expiration(now);
+        for (auto* r : expired) tw.publish(r, now + std::chrono::seconds(dist(gen)));
+        expired.clear();
+    }
+
+    for (auto& r : timers) r->unlink();
+}
+
+void BM_SlabTimerWheel_Tick(benchmark::State& state)
+{
+    const auto                      n = static_cast<std::size_t>(state.range(0));
+    std::mt19937                    gen(1337);
+    std::uniform_int_distribution<> dist(1, horizon);
+
+    std::vector<std::uint64_t> expired;
+
+    br::time_point       now;
+    br::slab_timer_wheel tw(std::chrono::seconds(1), n_slots, now);
+    tw.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) tw.publish(now + std::chrono::seconds(dist(gen)), i);
+
+    for (auto _ : state) {
+        now += std::chrono::seconds(1);
+        tw.check_expiration(now, [&](std::uint64_t d) { expired.push_back(d); });
+        for (auto d : expired) tw.publish(now + std::chrono::seconds(dist(gen)), d);
+        expired.clear();
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_TimerWheel_Tick)->RangeMultiplier(4)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SlabTimerWheel_Tick)->RangeMultiplier(4)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMicrosecond);
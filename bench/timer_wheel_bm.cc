@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "timer_wheel.h"
+#include "hierarchical_timer_wheel.h"
+
+namespace {
+
+struct T final: br::expirable {
+    void expire() override { benchmark::DoNotOptimize(this); }
+};
+
+constexpr auto horizon = std::chrono::seconds(3600);
+
+std::vector<std::chrono::seconds> deadlines(std::size_t n)
+{
+    std::vector<std::chrono::seconds> d(n);
+    std::mt19937                      gen(1337);
+    std::uniform_int_distribution<>   dist(1, horizon.count());
+    for (auto& s : d) s = std::chrono::seconds(dist(gen));
+    return d;
+}
+
+// A one hour worth of long timeouts drained one tick at a time
+template <typename WHEEL, typename... ARGS>
+void run_long_timeouts(benchmark::State& state, ARGS... args)
+{
+    const auto     d = deadlines(state.range(0));
+    std::vector<T> timers(d.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        const br::time_point t;
+        WHEEL                tw(std::chrono::seconds(1), args..., t);
+        for (std::size_t i = 0; i < d.size(); ++i) tw.publish(&timers[i], t + d[i]);
+        state.ResumeTiming();
+
+        for (auto s = std::chrono::seconds(1); s <= horizon + std::chrono::seconds(1); ++s) {
+            tw.check_expiration(t + s);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TimerWheel_LongTimeouts(benchmark::State& state)
+{
+    run_long_timeouts<br::timer_wheel>(state, std::size_t{100});
+}
+
+void BM_HierarchicalTimerWheel_LongTimeouts(benchmark::State& state)
+{
+    run_long_timeouts<br::hierarchical_timer_wheel>(state, std::size_t{64}, std::size_t{3});
+}
+
+struct TS final: br::ts_expirable {
+    void expire() override { benchmark::DoNotOptimize(this); }
+};
+
+// An idle timeout refreshed on every received packet
+void BM_TsTimerWheel_UnlinkPublish(benchmark::State& state)
+{
+    const br::time_point t;
+    br::ts_timer_wheel   tw(std::chrono::seconds(1), 128, t);
+    TS                   e;
+    tw.publish(&e, t + std::chrono::seconds(30));
+
+    auto d = std::chrono::seconds(30);
+    for (auto _ : state) {
+        e.unlink();
+        tw.publish(&e, t + d);
+        d = d == std::chrono::seconds(60) ? std::chrono::seconds(30) : d + std::chrono::seconds(1);
+    }
+}
+
+void BM_TsTimerWheel_Touch(benchmark::State& state)
+{
+    const br::time_point t;
+    br::ts_timer_wheel   tw(std::chrono::seconds(1), 128, t);
+    TS                   e;
+    tw.publish(&e, t + std::chrono::seconds(30));
+
+    std::chrono::nanoseconds d = std::chrono::seconds(30);
+    for (auto _ : state) {
+        tw.touch(&e, t + d);
+        d += std::chrono::nanoseconds(1);
+    }
+}
+
+// A few timers on a big, fine grained wheel checked after a long gap
+void BM_TimerWheel_CatchUp(benchmark::State& state)
+{
+    using ms_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex, std::chrono::milliseconds>;
+
+    std::vector<T>  timers(16);
+    br::time_point  now;
+    ms_timer_wheel  tw(std::chrono::milliseconds(1), 65536, now);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < timers.size(); ++i) {
+            tw.publish(&timers[i], now + std::chrono::milliseconds(i * 4099));
+        }
+        now += std::chrono::milliseconds(state.range(0));
+        state.ResumeTiming();
+
+        tw.check_expiration(now);
+
+        state.PauseTiming();
+        for (auto& e : timers) e.unlink();
+        state.ResumeTiming();
+    }
+}
+
+struct S final: br::basic_timer_entry<S> {
+    void expire() { benchmark::DoNotOptimize(this); }
+};
+
+// Publish and expire a batch of timers: virtual vs CRTP dispatch
+template <typename WHEEL, typename E>
+void run_expire(benchmark::State& state)
+{
+    std::vector<E> timers(state.range(0));
+    br::time_point now;
+    WHEEL          tw(std::chrono::seconds(1), 64, now);
+
+    for (auto _ : state) {
+        for (auto& e : timers) tw.publish(&e, now + std::chrono::seconds(1));
+        now += std::chrono::seconds(2);
+        tw.check_expiration(now);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TimerWheel_ExpireVirtual(benchmark::State& state)
+{
+    run_expire<br::timer_wheel, T>(state);
+}
+
+void BM_TimerWheel_ExpireStatic(benchmark::State& state)
+{
+    using static_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex,
+                                                     std::chrono::duration<uint64_t>,
+                                                     std::chrono::steady_clock,
+                                                     S>;
+    run_expire<static_timer_wheel, S>(state);
+}
+
+void BM_TimerWheel_ExpireStats(benchmark::State& state)
+{
+    using stats_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex,
+                                                    std::chrono::duration<uint64_t>,
+                                                    std::chrono::steady_clock,
+                                                    br::expirable,
+                                                    br::timer_wheel_stats>;
+    run_expire<stats_timer_wheel, T>(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_TimerWheel_ExpireStats)->Range(1024, 65536);
+BENCHMARK(BM_TimerWheel_ExpireVirtual)->Range(1024, 65536);
+BENCHMARK(BM_TimerWheel_ExpireStatic)->Range(1024, 65536);
+BENCHMARK(BM_TimerWheel_CatchUp)->RangeMultiplier(16)->Range(16, 1 << 24);
+BENCHMARK(BM_TsTimerWheel_UnlinkPublish);
+BENCHMARK(BM_TsTimerWheel_Touch);
+BENCHMARK(BM_TimerWheel_LongTimeouts)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HierarchicalTimerWheel_LongTimeouts)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
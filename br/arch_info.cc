@@ -238,5 +238,17 @@ void arch_info::set_this_thread_cpu_affinity(unsigned cpu_id) noexcept
 #endif
 }
 
+unsigned arch_info::current_cpu() noexcept
+{
+#if defined(_WIN32)
+    return GetCurrentProcessorNumber();
+#elif defined(__linux__)
+    const int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : static_cast<unsigned>(cpu);
+#else
+#error "Non supported platform"
+#endif
+}
+
 
 } // br
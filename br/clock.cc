@@ -0,0 +1,112 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "clock.h"
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BR_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BR_HAS_TSC 1
+#endif
+
+#include <thread>
+
+namespace br {
+
+coarse_steady_clock::time_point coarse_steady_clock::now() noexcept
+{
+#if defined(__linux__)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return time_point(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+#else
+    return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+#endif
+}
+
+#if defined(BR_HAS_TSC)
+namespace {
+// Nanoseconds are obtained as (tsc * mult) >> shift, to avoid a division per read
+constexpr unsigned tsc_shift = 24;
+
+struct tsc_calibration {
+    std::uint64_t mult;
+    double        frequency;
+
+    tsc_calibration() noexcept
+    {
+        const auto          s0 = std::chrono::steady_clock::now();
+        const std::uint64_t t0 = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const auto          s1 = std::chrono::steady_clock::now();
+        const std::uint64_t t1 = __rdtsc();
+
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(s1 - s0).count();
+        frequency     = static_cast<double>(t1 - t0) * 1e9 / static_cast<double>(ns);
+        mult          = static_cast<std::uint64_t>((1e9 / frequency) * (1ULL << tsc_shift));
+    }
+};
+
+const tsc_calibration& calibration() noexcept
+{
+    static const tsc_calibration c;
+    return c;
+}
+} // namespace
+
+tsc_clock::time_point tsc_clock::now() noexcept
+{
+    static const std::uint64_t mult = calibration().mult;
+#if defined(_MSC_VER)
+    std::uint64_t      hi;
+    const std::uint64_t lo = _umul128(__rdtsc(), mult, &hi);
+    const std::uint64_t ns = (lo >> tsc_shift) | (hi << (64 - tsc_shift));
+#else
+    const auto ns = static_cast<unsigned __int128>(__rdtsc()) * mult >> tsc_shift;
+#endif
+    return time_point(duration(static_cast<rep>(ns)));
+}
+
+double tsc_clock::frequency() noexcept
+{
+    return calibration().frequency;
+}
+#else
+tsc_clock::time_point tsc_clock::now() noexcept
+{
+    return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+}
+
+double tsc_clock::frequency() noexcept
+{
+    return 1e9;
+}
+#endif
+
+} // namespace br
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "cohort_lock.h"
+
+#include <vector>
+
+namespace br {
+namespace detail_ {
+namespace {
+struct numa_topology {
+    std::vector<unsigned> node_of_cpu;
+    unsigned              n_nodes{1};
+
+    numa_topology()
+    {
+        const arch_info ai;
+        if (!ai.info_ready() || ai.number_of_numa_nodes() == 0) return;
+
+        n_nodes = ai.number_of_numa_nodes();
+        for (unsigned i = 0; i < n_nodes; ++i) {
+            for (const auto& cpu : ai.numa_nodes()[i].cpus()) {
+                if (cpu.id() >= node_of_cpu.size()) node_of_cpu.resize(cpu.id() + 1, 0);
+                node_of_cpu[cpu.id()] = i;
+            }
+        }
+    }
+};
+
+const numa_topology& topology() noexcept
+{
+    static const numa_topology t;
+    return t;
+}
+} // namespace
+
+unsigned numa_node_of_cpu(unsigned cpu) noexcept
+{
+    const auto& t = topology();
+    return cpu < t.node_of_cpu.size() ? t.node_of_cpu[cpu] : 0;
+}
+
+unsigned numa_node_count() noexcept
+{
+    return topology().n_nodes;
+}
+} // namespace detail_
+} // namespace br
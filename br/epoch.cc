@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "epoch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace br {
+
+epoch_domain::epoch_domain(std::size_t max_threads)
+    : slots_(std::make_unique<slot[]>(max_threads))
+    , max_threads_(max_threads)
+{
+}
+
+epoch_domain::~epoch_domain()
+{
+    for (const auto& r : limbo_) r.deleter(r.p);
+}
+
+epoch_domain::guard::guard(epoch_domain& d) noexcept
+    : domain_(d)
+{
+    const auto i = detail_::thread_index();
+    overflow_    = i >= d.max_threads_;
+    if (overflow_) {
+        outer_ = false;
+        d.overflow_pins_.fetch_add(1, std::memory_order_relaxed);
+        // Same pairing with try_advance() as below
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return;
+    }
+
+    auto& s = d.slots_[i];
+    outer_  = s.nesting++ == 0;
+    if (outer_) {
+        s.state.store((d.epoch_.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+        // Orders the pin before any read of the shared objects, and pairs with the
+        // fence of try_advance(): either it sees this thread pinned or this thread sees
+        // the objects unlinked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+epoch_domain::guard::~guard()
+{
+    if (overflow_) {
+        domain_.overflow_pins_.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    auto& s = domain_.slots_[detail_::thread_index()];
+    --s.nesting;
+    if (outer_) s.state.store(0, std::memory_order_release);
+}
+
+bool epoch_domain::try_advance() noexcept
+{
+    const auto e = epoch_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Overflow threads do not record the epoch they pinned, so assume the oldest
+    if (overflow_pins_.load(std::memory_order_acquire) != 0) return false;
+
+    const auto bound = std::min<std::size_t>(detail_::thread_index_bound(), max_threads_);
+    for (std::size_t i = 0; i < bound; ++i) {
+        const auto state = slots_[i].state.load(std::memory_order_acquire);
+        if ((state & 1) && (state >> 1) != e) return false;
+    }
+
+    auto expected = e;
+    epoch_.compare_exchange_strong(expected, e + 1, std::memory_order_acq_rel);
+    return true;
+}
+
+void epoch_domain::retire(void* p, void (*deleter)(void*))
+{
+    // The object was unlinked before, so any thread pinned after this fence cannot
+    // reach it, and the epoch read here is at least the one those threads will pin
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::size_t pending;
+    {
+        std::lock_guard l(limbo_lock_);
+        limbo_.push_back({p, deleter, epoch_.load(std::memory_order_relaxed)});
+        pending = limbo_.size();
+    }
+
+    if (pending >= collect_threshold) collect();
+}
+
+std::size_t epoch_domain::collect()
+{
+    try_advance();
+
+    // Deleted outside the lock, deleters may retire more objects
+    std::vector<retired> ready;
+    {
+        const auto      e = epoch_.load(std::memory_order_acquire);
+        std::lock_guard l(limbo_lock_);
+        std::erase_if(limbo_, [&](const retired& r) {
+            if (r.epoch + 2 > e) return false;
+            ready.push_back(r);
+            return true;
+        });
+    }
+
+    for (const auto& r : ready) r.deleter(r.p);
+    return ready.size();
+}
+
+void epoch_domain::synchronize()
+{
+    for (;;) {
+        collect();
+        {
+            std::lock_guard l(limbo_lock_);
+            if (limbo_.empty()) return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+} // namespace br
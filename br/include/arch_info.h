@@ -29,6 +29,10 @@
 
 namespace br {
 
+// Alignment used to keep data written by different threads in different cache lines.
+// std::hardware_destructive_interference_size is not ABI stable across compiler flags.
+inline constexpr std::size_t cache_line_size = 64;
+
 class cpu_info {
     friend class arch_info;
 
@@ -67,6 +71,9 @@ public:
 
     static void set_this_thread_cpu_affinity(unsigned) noexcept;
 
+    // CPU the calling thread is running on right now
+    [[nodiscard]] static unsigned current_cpu() noexcept;
+
 private:
     std::vector<numa_node_info> numa_nodes_;
     bool                        info_ready_;
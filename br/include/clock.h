@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef BR_CLOCK_H_
+#define BR_CLOCK_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace br {
+
+// Steady clock with the resolution of the scheduler tick (CLOCK_MONOTONIC_COARSE on
+// Linux, a few ms). It is read from the vDSO without touching the hardware counter,
+// which makes it several times cheaper than std::chrono::steady_clock. On other
+// platforms it is just std::chrono::steady_clock.
+class coarse_steady_clock {
+public:
+    using duration                  = std::chrono::nanoseconds;
+    using rep                       = duration::rep;
+    using period                    = duration::period;
+    using time_point                = std::chrono::time_point<coarse_steady_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept;
+};
+
+// Steady clock reading the time stamp counter (x86 rdtsc), scaled to nanoseconds with a
+// multiplier calibrated against std::chrono::steady_clock on first use. It requires an
+// invariant TSC synchronized between cores, which is the case of any modern x86 CPU.
+// On other architectures it is just std::chrono::steady_clock.
+class tsc_clock {
+public:
+    using duration                  = std::chrono::nanoseconds;
+    using rep                       = duration::rep;
+    using period                    = duration::period;
+    using time_point                = std::chrono::time_point<tsc_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept;
+
+    // TSC ticks per second as measured by the calibration
+    [[nodiscard]] static double frequency() noexcept;
+};
+
+} // namespace br
+
+#endif // BR_CLOCK_H_
@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_COHORT_LOCK_H_
+#define BR_COHORT_LOCK_H_
+
+#include "arch_info.h"
+#include "fair_lock.h"
+#include "spinlock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace br {
+namespace detail_ {
+// NUMA node of a CPU as an index in [0, numa_node_count()), from arch_info's topology.
+// Everything maps to node 0 if the topology could not be read.
+[[nodiscard]] unsigned numa_node_of_cpu(unsigned cpu) noexcept;
+[[nodiscard]] unsigned numa_node_count() noexcept;
+} // namespace detail_
+
+// Cohort lock (Dice, Marathe & Shavit): a global lock plus one local ticket lock per
+// NUMA node. A thread takes its node's local lock, and the global one only if its
+// cohort does not hold it already. On unlock, if another thread of the same node is
+// waiting, the global lock is passed along with the local one, so the protected data
+// stays in the node's caches. After max_local_handoffs such passes in a row the global
+// lock is released anyway, so other nodes are not starved.
+//
+// GLOBAL must be releasable by a thread other than the one that took it, as the
+// ticket_lock is.
+template <typename GLOBAL = ticket_lock>
+class cohort_lock {
+public:
+    explicit cohort_lock(unsigned max_local_handoffs = 64)
+        : nodes_(std::make_unique<node[]>(detail_::numa_node_count()))
+        , max_local_handoffs_(max_local_handoffs)
+    {
+    }
+
+    cohort_lock(cohort_lock&)             = delete;
+    cohort_lock(cohort_lock&&)            = delete;
+    cohort_lock& operator=(cohort_lock&)  = delete;
+    cohort_lock& operator=(cohort_lock&&) = delete;
+
+    void lock()
+    {
+        auto&      n      = local_node();
+        const auto ticket = n.next.fetch_add(1, std::memory_order_relaxed);
+
+        detail_::backoff<> b;
+        while (n.serving.load(std::memory_order_acquire) != ticket) b.pause_or_yield();
+
+        if (!n.global_held) {
+            global_.lock();
+            n.global_held = true;
+            n.handoffs    = 0;
+        }
+        owner_ = &n;
+    }
+
+    [[nodiscard]] bool try_lock()
+    {
+        auto& n       = local_node();
+        auto  serving = n.serving.load(std::memory_order_relaxed);
+        if (!n.next.compare_exchange_strong(serving, serving + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return false;
+        }
+
+        if (!n.global_held) {
+            if (!global_.try_lock()) {
+                n.serving.store(serving + 1, std::memory_order_release);
+                return false;
+            }
+            n.global_held = true;
+            n.handoffs    = 0;
+        }
+        owner_ = &n;
+        return true;
+    }
+
+    void unlock() noexcept
+    {
+        // The owner may have migrated to another node since it locked
+        auto&      n       = *owner_;
+        const auto serving = n.serving.load(std::memory_order_relaxed);
+
+        const bool local_waiter = n.next.load(std::memory_order_relaxed) != serving + 1;
+        if (!local_waiter || ++n.handoffs >= max_local_handoffs_) {
+            n.global_held = false;
+            global_.unlock();
+        }
+        n.serving.store(serving + 1, std::memory_order_release);
+    }
+
+private:
+    struct alignas(cache_line_size) node {
+        std::atomic<std::uint32_t> next{0};
+        std::atomic<std::uint32_t> serving{0};
+
+        // Only touched by the local lock owner
+        bool     global_held{false};
+        unsigned handoffs{0};
+    };
+
+    node& local_node() noexcept { return nodes_[detail_::numa_node_of_cpu(arch_info::current_cpu())]; }
+
+    GLOBAL                  global_;
+    std::unique_ptr<node[]> nodes_;
+    const unsigned          max_local_handoffs_;
+
+    node* owner_{nullptr};
+};
+} // namespace br
+
+#endif // BR_COHORT_LOCK_H_
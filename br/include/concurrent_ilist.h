@@ -0,0 +1,166 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_CONCURRENT_ILIST_H_
+#define BR_CONCURRENT_ILIST_H_
+
+#include "epoch.h"
+#include "ilist.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace br {
+
+// Intrusive list for read-mostly sets (registries, subscribers) whose readers never
+// lock: they follow next pointers published with release stores while pinned to an
+// epoch_domain. Writers serialize on MUTEX_LOCK and never block readers. A node erased
+// from the list still points into it, so readers standing on it can carry on; it must
+// not be destroyed, or linked again, until a grace period has passed: retire it to the
+// domain (erase_and_retire() does both) or call domain.synchronize() first.
+template <typename T, typename MUTEX_LOCK=std::mutex, typename TAG=void>
+class concurrent_ilist {
+public:
+    class node {
+        friend class concurrent_ilist;
+
+    public:
+        [[nodiscard]] bool linked() const noexcept { return linked_; }
+
+    protected:
+        ~node() = default;
+
+    private:
+        std::atomic<node*> next_{nullptr};
+        node*              prev_{nullptr};
+        bool               linked_{false};
+    };
+
+    explicit concurrent_ilist(epoch_domain& domain) noexcept
+        : domain_(domain)
+    {
+    }
+
+    concurrent_ilist(const concurrent_ilist&)            = delete;
+    concurrent_ilist& operator=(const concurrent_ilist&) = delete;
+
+    // Readers
+
+    // Calls fn(T&) for every node, pinning the domain for the whole traversal. It sees
+    // every node linked before it started and not erased until it finished, and may or
+    // may not see the others.
+    template <typename FN>
+    void for_each(FN fn) const
+    {
+        const auto g = domain_.pin();
+        for (auto* n = head_.next_.load(std::memory_order_acquire); n; n = n->next_.load(std::memory_order_acquire)) {
+            fn(*static_cast<T*>(n));
+        }
+    }
+
+    // First node for which pred returns true, or nullptr. The pointer is only safe to
+    // use while the caller keeps the domain pinned, or if it knows nobody retires it.
+    template <typename PRED>
+    T* find_if(PRED pred) const
+    {
+        const auto g = domain_.pin();
+        for (auto* n = head_.next_.load(std::memory_order_acquire); n; n = n->next_.load(std::memory_order_acquire)) {
+            if (pred(*static_cast<T*>(n))) return static_cast<T*>(n);
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return n_entries_.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool        empty() const noexcept { return size() == 0; }
+
+    // Writers
+
+    // False if n is already linked, as for ilist
+    bool push_front(node* n)
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        if (n->linked_) return false;
+        link_after(&head_, n);
+        return true;
+    }
+
+    bool push_back(node* n)
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        if (n->linked_) return false;
+        link_after(tail_, n);
+        return true;
+    }
+
+    // False if n was not linked
+    bool erase(node* n)
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        if (!n->linked_) return false;
+
+        auto* next = n->next_.load(std::memory_order_relaxed);
+        n->prev_->next_.store(next, std::memory_order_release);
+        if (next) next->prev_ = n->prev_;
+        else tail_ = n->prev_;
+
+        n->linked_ = false;
+        n_entries_.store(n_entries_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Erases n and deletes it (as a T) once no reader can be on it anymore
+    bool erase_and_retire(T* n)
+    {
+        if (!erase(n)) return false;
+        domain_.retire(n);
+        return true;
+    }
+
+    [[nodiscard]] epoch_domain& domain() const noexcept { return domain_; }
+
+private:
+    void link_after(node* pos, node* n) noexcept
+    {
+        auto* next = pos->next_.load(std::memory_order_relaxed);
+        n->next_.store(next, std::memory_order_relaxed);
+        n->prev_   = pos;
+        n->linked_ = true;
+        if (next) next->prev_ = n;
+        else tail_ = n;
+
+        // Publishes n fully built
+        pos->next_.store(n, std::memory_order_release);
+        n_entries_.store(n_entries_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    epoch_domain& domain_;
+
+    node                     head_;
+    node*                    tail_{&head_};
+    std::atomic<std::size_t> n_entries_{0};
+
+    MUTEX_LOCK mutex_lck_;
+};
+} // namespace br
+
+#endif // BR_CONCURRENT_ILIST_H_
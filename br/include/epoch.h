@@ -0,0 +1,119 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_EPOCH_H_
+#define BR_EPOCH_H_
+
+#include "arch_info.h"
+#include "thread_index.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace br {
+// Epoch based reclamation. Readers pin the domain while they hold pointers to shared
+// objects, writers retire the objects they unlink instead of deleting them, and an
+// object is deleted once every thread has been seen outside of a critical section, or
+// in a later epoch, since it was retired: two epoch advances after its own.
+//
+// Pinning is two stores and a fence on a slot private to the thread, so readers never
+// contend with each other or with writers. Slots are indexed by detail_::thread_index(),
+// the threads with an index of max_threads or more share a single pin counter instead:
+// they are always safe, but while any of them is pinned the epoch cannot advance.
+class epoch_domain {
+public:
+    explicit epoch_domain(std::size_t max_threads = 256);
+    ~epoch_domain();
+
+    epoch_domain(const epoch_domain&)            = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    // Keeps the calling thread in a critical section while alive. Guards nest.
+    class guard {
+    public:
+        explicit guard(epoch_domain& d) noexcept;
+        ~guard();
+
+        guard(const guard&)            = delete;
+        guard& operator=(const guard&) = delete;
+
+    private:
+        epoch_domain& domain_;
+        bool          outer_;
+        bool          overflow_; // Pinned through overflow_pins_ rather than a slot
+    };
+
+    [[nodiscard]] guard pin() noexcept { return guard(*this); }
+
+    // Deletes p with deleter(p) once no reader can hold it anymore
+    void retire(void* p, void (*deleter)(void*));
+
+    template <typename T>
+    void retire(T* p)
+    {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    // Advances the epoch if every pinned thread has caught up with it and deletes what
+    // became safe to. Returns the number of objects deleted.
+    std::size_t collect();
+
+    // Waits until everything retired so far has been deleted. Not from a pinned thread.
+    void synchronize();
+
+    [[nodiscard]] std::uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_acquire); }
+
+private:
+    // Epoch of the thread shifted by one, with the low bit set while it is pinned
+    struct alignas(cache_line_size) slot {
+        std::atomic<std::uint64_t> state{0};
+        unsigned                   nesting{0};
+    };
+
+    struct retired {
+        void* p;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    bool try_advance() noexcept;
+
+    static constexpr std::size_t collect_threshold = 64;
+
+    alignas(cache_line_size) std::atomic<std::uint64_t> epoch_{0};
+
+    // Guards held by threads without a slot
+    alignas(cache_line_size) std::atomic<std::size_t> overflow_pins_{0};
+
+    std::unique_ptr<slot[]> slots_;
+    const std::size_t       max_threads_;
+
+    std::mutex           limbo_lock_;
+    std::vector<retired> limbo_;
+};
+} // namespace br
+
+#endif // BR_EPOCH_H_
@@ -0,0 +1,193 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_FAIR_LOCK_H_
+#define BR_FAIR_LOCK_H_
+
+#include "arch_info.h"
+#include "spinlock.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace br {
+
+// FIFO spinlocks with the lock()/unlock()/try_lock() shape of MUTEX_LOCK. Threads get
+// the lock in the order they asked for it, so none starves, at the cost of handing it
+// to a waiter that may have been descheduled: waiters yield their CPU after spinning
+// for a while so the queue keeps moving when there are more threads than cores.
+
+// Ticket lock: take a number and wait to be served. Waiters back off in proportion to
+// their distance to the head of the queue, but they all spin on the same line.
+class ticket_lock {
+public:
+    ticket_lock() noexcept                = default;
+    ticket_lock(ticket_lock&)             = delete;
+    ticket_lock(ticket_lock&&)            = delete;
+    ticket_lock& operator=(ticket_lock&)  = delete;
+    ticket_lock& operator=(ticket_lock&&) = delete;
+
+    void lock() noexcept
+    {
+        const auto ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        unsigned   spins  = 0;
+        for (;;) {
+            const auto serving = serving_.load(std::memory_order_acquire);
+            if (serving == ticket) return;
+
+            if (spins < max_spins) {
+                const auto ahead = ticket - serving;
+                for (std::uint32_t i = 0; i < ahead * spins_per_waiter; ++i) detail_::cpu_relax();
+                spins += ahead * spins_per_waiter;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() noexcept
+    {
+        // Only the owner writes serving_
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool try_lock() noexcept
+    {
+        auto serving = serving_.load(std::memory_order_relaxed);
+        return next_.compare_exchange_strong(serving, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::uint32_t spins_per_waiter = 32;
+    static constexpr std::uint32_t max_spins        = 1 << 10;
+
+    std::atomic<std::uint32_t> next_{0};
+    std::atomic<std::uint32_t> serving_{0};
+};
+
+namespace detail_ {
+struct alignas(cache_line_size) mcs_node {
+    std::atomic<mcs_node*> next{nullptr};
+    std::atomic<bool>      waiting{false};
+    mcs_node*              free_next{nullptr};
+};
+
+// Queue nodes of the calling thread, one per lock it holds or waits for
+class mcs_node_pool {
+public:
+    ~mcs_node_pool()
+    {
+        while (free_) delete std::exchange(free_, free_->free_next);
+    }
+
+    mcs_node* acquire()
+    {
+        if (!free_) return new mcs_node;
+        return std::exchange(free_, free_->free_next);
+    }
+
+    void release(mcs_node* n) noexcept { n->free_next = std::exchange(free_, n); }
+
+private:
+    mcs_node* free_{nullptr};
+};
+
+inline thread_local mcs_node_pool mcs_nodes;
+} // namespace detail_
+
+// Mellor-Crummey & Scott lock: waiters queue up in a linked list and each spins on a
+// flag in its own node, on its own cache line, which its predecessor clears when it
+// leaves. A handover touches only the two threads involved, so the lock scales flat
+// with the number of waiters. Must be unlocked by the thread that locked it.
+class mcs_lock {
+public:
+    mcs_lock() noexcept             = default;
+    mcs_lock(mcs_lock&)             = delete;
+    mcs_lock(mcs_lock&&)            = delete;
+    mcs_lock& operator=(mcs_lock&)  = delete;
+    mcs_lock& operator=(mcs_lock&&) = delete;
+
+    void lock()
+    {
+        auto* n = detail_::mcs_nodes.acquire();
+        n->next.store(nullptr, std::memory_order_relaxed);
+        n->waiting.store(true, std::memory_order_relaxed);
+
+        if (auto* pred = tail_.exchange(n, std::memory_order_acq_rel)) {
+            pred->next.store(n, std::memory_order_release);
+
+            detail_::backoff<> b;
+            while (n->waiting.load(std::memory_order_acquire)) b.pause_or_yield();
+        }
+        owner_ = n;
+    }
+
+    void unlock() noexcept
+    {
+        auto* n = owner_;
+        assert(n && "Unlocking a non-locked mcs_lock");
+
+        auto* succ = n->next.load(std::memory_order_acquire);
+        if (!succ) {
+            auto expected = n;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                detail_::mcs_nodes.release(n);
+                return;
+            }
+            // A successor swapped the tail but has not linked itself yet
+            detail_::backoff<> b;
+            while (!(succ = n->next.load(std::memory_order_acquire))) b.pause_or_yield();
+        }
+
+        succ->waiting.store(false, std::memory_order_release);
+        detail_::mcs_nodes.release(n);
+    }
+
+    [[nodiscard]] bool try_lock()
+    {
+        auto* n = detail_::mcs_nodes.acquire();
+        n->next.store(nullptr, std::memory_order_relaxed);
+
+        mcs_node_ptr expected = nullptr;
+        if (!tail_.compare_exchange_strong(expected, n, std::memory_order_acquire, std::memory_order_relaxed)) {
+            detail_::mcs_nodes.release(n);
+            return false;
+        }
+        owner_ = n;
+        return true;
+    }
+
+private:
+    using mcs_node_ptr = detail_::mcs_node*;
+
+    alignas(cache_line_size) std::atomic<mcs_node_ptr> tail_{nullptr};
+
+    // Node of the current owner, only touched by it
+    mcs_node_ptr owner_{nullptr};
+};
+} // namespace br
+
+#endif // BR_FAIR_LOCK_H_
@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2024 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_HIERARCHICAL_TIMER_WHEEL_H_
+#define BR_HIERARCHICAL_TIMER_WHEEL_H_
+
+#include "timer_wheel.h"
+
+#include <bit>
+#include <cassert>
+
+namespace br {
+
+using hierarchical_timer_wheel    = basic_hierarchical_timer_wheel<>;
+using ts_hierarchical_timer_wheel = basic_hierarchical_timer_wheel<std::mutex>;
+
+// Varghese & Lauck hierarchical timer wheel. Level 0 has one slot per tick, every
+// upper level has slots ns times wider than the level below. Timers are placed in
+// the lowest level able to hold them and are cascaded down as time approaches their
+// deadline, so every timer is touched at most once per level no matter how far away
+// its deadline is. Timers further away than ns^nl ticks are parked in the top level
+// and re-placed each time the top level comes around.
+template <typename MUTEX_LOCK, typename DURATION, typename CLOCK, typename ENTRY>
+class basic_hierarchical_timer_wheel {
+public:
+    using clock      = CLOCK;
+    using duration   = DURATION;
+    using time_point = typename CLOCK::time_point;
+    using entry_type = ENTRY;
+
+    explicit basic_hierarchical_timer_wheel(const duration   sd,
+                                            std::size_t      ns,
+                                            std::size_t      nl,
+                                            const time_point st) noexcept
+        : c_tick_(0)
+        , start_time_(st)
+        , slot_duration_(sd)
+        , slot_bits_(std::countr_zero(ns))
+        , slot_mask_(ns - 1)
+        , n_levels_(nl)
+        , slots_(ns * nl)
+    {
+        assert(std::has_single_bit(ns) && "The number of slots per level must be a power of two");
+        assert(nl > 0 && slot_bits_ * nl < 64 && "The number of levels must fit a 64 bits tick");
+    }
+
+    void check_expiration(const time_point now)
+    {
+        auto nSlotsTraversed =
+            now > start_time_ ? static_cast<std::uint64_t>((now - start_time_) / slot_duration_) : 0;
+        start_time_ += (nSlotsTraversed * slot_duration_);
+
+        while (nSlotsTraversed--) {
+            for (std::size_t level = 1; level < n_levels_; ++level) {
+                if (c_tick_ & ((std::uint64_t{1} << (level * slot_bits_)) - 1)) break;
+                cascade(slot(level, c_tick_));
+            }
+
+            auto& s = slot(0, c_tick_);
+            while (auto* e = s.pop_front()) {
+                e->expire();
+            }
+            ++c_tick_;
+        }
+    }
+
+    void publish(ENTRY* e, const time_point expirationTime) noexcept
+    {
+        e->expiry_tick_ = c_tick_;
+        if (expirationTime > start_time_) {
+            e->expiry_tick_ += static_cast<std::uint64_t>((expirationTime - start_time_) / slot_duration_);
+        }
+
+        place(e);
+    }
+
+private:
+    using slot_list = ilist<ENTRY, MUTEX_LOCK>;
+
+    slot_list& slot(std::size_t level, std::uint64_t tick) noexcept
+    {
+        return slots_[(level << slot_bits_) + ((tick >> (level * slot_bits_)) & slot_mask_)];
+    }
+
+    void place(ENTRY* e) noexcept
+    {
+        const std::uint64_t delta = e->expiry_tick_ - c_tick_;
+
+        for (std::size_t level = 0; level < n_levels_; ++level) {
+            if (delta >> ((level + 1) * slot_bits_) == 0) {
+                slot(level, e->expiry_tick_).push_back(e);
+                return;
+            }
+        }
+
+        // Beyond the range of the wheel: park it in the last slot the top level can reach.
+        const std::size_t   top   = n_levels_ - 1;
+        const std::uint64_t reach = (std::uint64_t{1} << (n_levels_ * slot_bits_)) - 1;
+        slot(top, c_tick_ + reach).push_back(e);
+    }
+
+    void cascade(slot_list& s) noexcept
+    {
+        while (auto* e = s.pop_front()) {
+            place(e);
+        }
+    }
+
+    std::uint64_t c_tick_;
+    time_point    start_time_;
+
+    const duration      slot_duration_;
+    const std::size_t   slot_bits_;
+    const std::uint64_t slot_mask_;
+    const std::size_t   n_levels_;
+
+    std::vector<slot_list> slots_;
+};
+} // namespace br
+
+#endif // BR_HIERARCHICAL_TIMER_WHEEL_H_
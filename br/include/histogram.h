@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_HISTOGRAM_H_
+#define BR_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace br {
+
+// Log-linear (HDR style) histogram of 64 bits values. Values below 2^SUB_BITS have
+// a bucket each, every power of two above is split in 2^SUB_BITS buckets, so the
+// relative error of any value is below 2^-SUB_BITS. Buckets are relaxed atomics:
+// record() is wait-free and snapshot() can be called from any thread, although a
+// snapshot taken while recording is not an atomic view of all the buckets.
+template <unsigned SUB_BITS = 4>
+class log_histogram {
+    static_assert(SUB_BITS > 0 && SUB_BITS < 16);
+
+public:
+    static constexpr std::size_t n_buckets = std::size_t{65 - SUB_BITS} << SUB_BITS;
+
+    [[nodiscard]] static constexpr std::size_t bucket_of(std::uint64_t v) noexcept
+    {
+        if (v < (std::uint64_t{1} << SUB_BITS)) return static_cast<std::size_t>(v);
+
+        const unsigned e = std::bit_width(v) - 1;
+        return (std::size_t{e - SUB_BITS + 1} << SUB_BITS) + ((v >> (e - SUB_BITS)) & sub_mask);
+    }
+
+    // Smallest and largest value recorded in bucket i
+    [[nodiscard]] static constexpr std::uint64_t lowest_of(std::size_t i) noexcept
+    {
+        if (i < (std::size_t{1} << SUB_BITS)) return i;
+
+        const unsigned e = static_cast<unsigned>(i >> SUB_BITS) + SUB_BITS - 1;
+        return ((std::uint64_t{1} << SUB_BITS) + (i & sub_mask)) << (e - SUB_BITS);
+    }
+
+    [[nodiscard]] static constexpr std::uint64_t highest_of(std::size_t i) noexcept
+    {
+        return i + 1 < n_buckets ? lowest_of(i + 1) - 1 : std::numeric_limits<std::uint64_t>::max();
+    }
+
+    class snapshot_type {
+    public:
+        [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+        [[nodiscard]] std::uint64_t sum() const noexcept { return sum_; }
+        [[nodiscard]] std::uint64_t bucket(std::size_t i) const noexcept { return buckets_[i]; }
+
+        [[nodiscard]] double mean() const noexcept
+        {
+            return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+        }
+
+        // Highest value equivalent to the q-th quantile (0 <= q <= 1), 0 if empty
+        [[nodiscard]] std::uint64_t percentile(double q) const noexcept
+        {
+            if (!count_) return 0;
+
+            auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count_));
+            if (rank >= count_) rank = count_ - 1;
+
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < n_buckets; ++i) {
+                seen += buckets_[i];
+                if (seen > rank) return highest_of(i);
+            }
+            return max();
+        }
+
+        [[nodiscard]] std::uint64_t max() const noexcept
+        {
+            for (auto i = n_buckets; i-- > 0;) {
+                if (buckets_[i]) return highest_of(i);
+            }
+            return 0;
+        }
+
+    private:
+        friend class log_histogram;
+
+        std::array<std::uint64_t, n_buckets> buckets_{};
+        std::uint64_t                        count_{0};
+        std::uint64_t                        sum_{0};
+    };
+
+    void record(std::uint64_t v) noexcept
+    {
+        buckets_[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(v, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] snapshot_type snapshot() const noexcept
+    {
+        snapshot_type s;
+        for (std::size_t i = 0; i < n_buckets; ++i) {
+            s.buckets_[i] = buckets_[i].load(std::memory_order_relaxed);
+            s.count_ += s.buckets_[i];
+        }
+        s.sum_ = sum_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset() noexcept
+    {
+        for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::uint64_t sub_mask = (std::uint64_t{1} << SUB_BITS) - 1;
+
+    std::array<std::atomic<std::uint64_t>, n_buckets> buckets_{};
+    std::atomic<std::uint64_t>                        sum_{0};
+};
+} // namespace br
+
+#endif // BR_HISTOGRAM_H_
@@ -23,16 +23,64 @@
 #ifndef BR_ILIST_H_
 #define BR_ILIST_H_
 
+#include <atomic>
+#include <cassert>
+#include <functional>
 #include <mutex>
+#include <type_traits>
 
 namespace br {
 
-namespace detail_ { struct void_mutex { void lock() noexcept {} void unlock() noexcept {} }; }
+namespace detail_ {
+struct void_mutex { void lock() noexcept {} void unlock() noexcept {} };
 
-template <typename T, typename MUTEX_LOCK=detail_::void_mutex>
+// Locks two mutexes, always in the same (address) order so two threads locking the
+// same pair from opposite ends cannot deadlock
+template <typename MUTEX_LOCK>
+class pair_lock {
+public:
+    pair_lock(MUTEX_LOCK& a, MUTEX_LOCK& b) noexcept
+        : first_(std::less<>{}(&a, &b) ? a : b)
+        , second_(std::less<>{}(&a, &b) ? b : a)
+    {
+        first_.lock();
+        second_.lock();
+    }
+
+    ~pair_lock()
+    {
+        second_.unlock();
+        first_.unlock();
+    }
+
+    pair_lock(const pair_lock&)            = delete;
+    pair_lock& operator=(const pair_lock&) = delete;
+
+private:
+    MUTEX_LOCK& first_;
+    MUTEX_LOCK& second_;
+};
+} // namespace detail_
+
+// What the destructor of a node does when it is still linked. auto_unlink takes it out
+// of its list (locking the list), normal leaves that to the user and only asserts.
+enum class link_mode { auto_unlink, normal };
+
+// T derives from ilist<T, ...>::node, the hook, once per list it can be linked to. The
+// hook holds three pointers and no vtable. Lists of the same T tell their hooks apart
+// by TAG, so an object can be in several lists at once:
+//
+//     struct lru_tag;
+//     struct session: br::ilist<session>::node, br::ilist<session, std::mutex, lru_tag>::node {};
+template <typename T,
+          typename MUTEX_LOCK=detail_::void_mutex,
+          typename TAG=void,
+          link_mode MODE=link_mode::auto_unlink>
 class ilist {
     friend class node;
 
+    static constexpr bool concurrent = !std::is_same_v<MUTEX_LOCK, detail_::void_mutex>;
+
 public:
     class iterator;
 
@@ -43,31 +91,74 @@ public:
     public:
         T* link_node_before(node* node) noexcept
         {
-            return parent_list_ ? parent_list_->link_node_before(this, node) : nullptr;
+            auto* list = parent();
+            return list ? list->link_node_before(this, node) : nullptr;
         }
 
         T* link_node_after(node* node) noexcept
         {
-            return parent_list_ ? parent_list_->link_node_after(this, node) : nullptr;
+            auto* list = parent();
+            return list ? list->link_node_after(this, node) : nullptr;
         }
 
+        // The list is read before taking its lock, so the node may have been moved to
+        // another list meanwhile (spliced by another thread): then it follows it there.
+        // That list must still be alive, lists that nodes can be moved out of while they
+        // are being unlinked must outlive those calls.
         void unlink() noexcept
         {
-            if (parent_list_) parent_list_->unlink_node(this);
+            for (auto* list = parent(); list && !list->unlink_node(this); list = parent()) {}
         }
 
-        virtual ~node() noexcept { unlink(); }
+        [[nodiscard]] bool linked() const noexcept { return parent() != nullptr; }
 
         const T* next() const noexcept { return static_cast<const T*>(next_); }
         const T* prev() const noexcept { return static_cast<const T*>(prev_); }
 
+    protected:
+        // Not virtual, so the hook does not add a vtable pointer to T. Elements are
+        // deleted through T, never through the node.
+        ~node() noexcept
+        {
+            if constexpr (MODE == link_mode::auto_unlink) {
+                unlink();
+            }
+            else {
+                assert(!parent() && "Destroying a node still linked to a list");
+            }
+        }
+
     private:
+        // unlink() and linked() read the list without its lock, so on a locked list the
+        // pointer is accessed atomically
+        ilist* parent() const noexcept
+        {
+            if constexpr (concurrent) {
+                return std::atomic_ref<ilist*>(const_cast<ilist*&>(parent_list_)).load(std::memory_order_relaxed);
+            }
+            else {
+                return parent_list_;
+            }
+        }
+
+        void set_parent(ilist* list) noexcept
+        {
+            if constexpr (concurrent) {
+                std::atomic_ref<ilist*>(parent_list_).store(list, std::memory_order_relaxed);
+            }
+            else {
+                parent_list_ = list;
+            }
+        }
+
         node*  prev_{nullptr};
         node*  next_{nullptr};
         ilist* parent_list_{nullptr};
     };
 
     class iterator {
+        friend class ilist;
+
     public:
 
         using value_type        = T;
@@ -111,8 +202,15 @@ public:
         head_.next_        = &tail_;
         tail_.prev_        = &head_;
         tail_.next_        = nullptr;
-        head_.parent_list_ = this;
-        tail_.parent_list_ = this;
+        head_.set_parent(this);
+        tail_.set_parent(this);
+    }
+
+    ~ilist()
+    {
+        clear();
+        head_.set_parent(nullptr);
+        tail_.set_parent(nullptr);
     }
 
     void push_front(node* node) noexcept
@@ -153,6 +251,9 @@ public:
         return static_cast<T*>(tail_.prev_);
     }
 
+    // Unlinks node if it is in this list, under the lock. False if it is not.
+    bool erase(node* node) { return unlink_node(node); }
+
     [[nodiscard]] size_t size() const noexcept { return n_entries_; }
     [[nodiscard]] bool   empty() const noexcept { return n_entries_ == 0; }
 
@@ -163,7 +264,7 @@ public:
 
         auto* node = head_.next_;
         while (node != &tail_) {
-            node->parent_list_ = nullptr;
+            node->set_parent(nullptr);
             node = node->next_;
         }
 
@@ -171,11 +272,109 @@ public:
         tail_.prev_ = &head_;
     }
 
+    // Links the nodes of the range [first, last) of T* at the back, in order, taking
+    // the lock once. Nodes already linked to a list are skipped.
+    template <typename IT>
+    std::size_t push_back_batch(IT first, IT last)
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+
+        std::size_t n = 0;
+        for (; first != last; ++first) {
+            node* node = *first;
+            if (node->parent()) continue;
+            non_locking_link_before(&tail_, node);
+            ++n;
+        }
+        return n;
+    }
+
+    // Calls fn(T&) for every node with the lock held
+    template <typename FN>
+    void for_each(FN fn)
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        for (auto* node = head_.next_; node != &tail_; node = node->next_) {
+            fn(*static_cast<T*>(node));
+        }
+    }
+
+    // Moves the nodes of other for which pred returns true to the back of this list,
+    // taking each lock once. pred runs with both locks held. Returns the number of
+    // nodes moved.
+    template <typename PRED>
+    std::size_t splice_if(ilist& other, PRED pred)
+    {
+        if (&other == this) return 0;
+        const detail_::pair_lock<MUTEX_LOCK> l(mutex_lck_, other.mutex_lck_);
+
+        std::size_t n = 0;
+        auto*       node = other.head_.next_;
+        while (node != &other.tail_) {
+            auto* next = node->next_;
+            if (pred(*static_cast<T*>(node))) {
+                other.non_locking_unlink_node(node);
+                non_locking_link_before(&tail_, node);
+                ++n;
+            }
+            node = next;
+        }
+        return n;
+    }
+
+    // Moves every node of other to the back of this list, taking each lock once. The
+    // nodes are relinked in O(1) and their list pointer is fixed in a single pass.
+    // Returns the number of nodes moved.
+    std::size_t splice(ilist& other)
+    {
+        if (&other == this) return 0;
+        const detail_::pair_lock<MUTEX_LOCK> l(mutex_lck_, other.mutex_lck_);
+        return non_locking_splice(other, other.head_.next_, &other.tail_);
+    }
+
+    // Same for the range [first, last) of other
+    std::size_t splice(ilist& other, iterator first, iterator last)
+    {
+        if (&other == this) return 0;
+        const detail_::pair_lock<MUTEX_LOCK> l(mutex_lck_, other.mutex_lck_);
+        return non_locking_splice(other, first.current_, last.current_);
+    }
+
+    // Moves every node of this list to the back of other, see splice()
+    std::size_t drain_to(ilist& other) { return other.splice(*this); }
+
 private:
-    void unlink_node(node* node)
+    std::size_t non_locking_splice(ilist& other, node* first, node* last) noexcept
+    {
+        if (first == last) return 0;
+        auto* back = last->prev_;
+
+        first->prev_->next_ = last;
+        last->prev_         = first->prev_;
+
+        first->prev_       = tail_.prev_;
+        tail_.prev_->next_ = first;
+        back->next_        = &tail_;
+        tail_.prev_        = back;
+
+        std::size_t n = 1;
+        for (auto* node = first; node != back; node = node->next_, ++n) {
+            node->set_parent(this);
+        }
+        back->set_parent(this);
+
+        other.n_entries_ -= n;
+        n_entries_ += n;
+        return n;
+    }
+
+    // False if the node was not in this list anymore when the lock was taken
+    bool unlink_node(node* node)
     {
         std::lock_guard<MUTEX_LOCK> lock(mutex_lck_);
+        if (node->parent() != this) return false;
         non_locking_unlink_node(node);
+        return true;
     }
 
     void non_locking_unlink_node(node* node)
@@ -184,18 +383,23 @@ private:
         if (node->next_) node->next_->prev_ = node->prev_;
         --n_entries_;
 
-        node->parent_list_ = nullptr;
+        node->set_parent(nullptr);
         node->prev_        = nullptr;
         node->next_        = nullptr;
     }
 
     T* link_node_before(node* current, node* node)
     {
-        if (node->parent_list_) return nullptr;
+        if (node->parent()) return nullptr;
 
         std::lock_guard<MUTEX_LOCK> lock(mutex_lck_);
+        if (node->parent()) return nullptr;
+        return non_locking_link_before(current, node);
+    }
 
-        node->parent_list_ = current->parent_list_;
+    T* non_locking_link_before(node* current, node* node)
+    {
+        node->set_parent(current->parent());
         node->next_        = current;
         node->prev_        = current->prev_;
 
@@ -207,11 +411,12 @@ private:
 
     T* link_node_after(node* current, node* node)
     {
-        if (node->parent_list_) return nullptr;
+        if (node->parent()) return nullptr;
 
         std::lock_guard<MUTEX_LOCK> lock(mutex_lck_);
+        if (node->parent()) return nullptr;
 
-        node->parent_list_ = current->parent_list_;
+        node->set_parent(current->parent());
         node->prev_        = current;
         node->next_        = current->next_;
 
@@ -0,0 +1,111 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_IMPSC_QUEUE_H_
+#define BR_IMPSC_QUEUE_H_
+
+#include "arch_info.h"
+
+#include <atomic>
+
+namespace br {
+
+// Vyukov's intrusive multi-producer single-consumer queue. Objects embed the node, as
+// with ilist, so handing them over allocates nothing. push() is wait-free: one
+// exchange on the head and one store, from any thread. pop() must be called from a
+// single consumer thread at a time and is lock-free, but it returns nullptr while a
+// producer is between its two steps even though the queue is not empty; the object
+// shows up on a later pop().
+template <typename T>
+class impsc_queue {
+public:
+    class node {
+        friend class impsc_queue;
+
+    protected:
+        ~node() = default;
+
+    private:
+        std::atomic<node*> next_{nullptr};
+    };
+
+    impsc_queue() noexcept
+        : head_(&stub_)
+        , tail_(&stub_)
+    {
+    }
+
+    impsc_queue(const impsc_queue&)            = delete;
+    impsc_queue& operator=(const impsc_queue&) = delete;
+
+    void push(node* n) noexcept
+    {
+        n->next_.store(nullptr, std::memory_order_relaxed);
+        auto* prev = head_.exchange(n, std::memory_order_acq_rel);
+        prev->next_.store(n, std::memory_order_release);
+    }
+
+    T* pop() noexcept
+    {
+        auto* tail = tail_;
+        auto* next = tail->next_.load(std::memory_order_acquire);
+
+        if (tail == &stub_) {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail  = next;
+            next  = next->next_.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            tail_ = next;
+            return static_cast<T*>(tail);
+        }
+
+        // tail is the last object unless a push is in progress
+        if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+
+        // Put the stub back behind it, so tail can be handed out
+        push(&stub_);
+        next = tail->next_.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return static_cast<T*>(tail);
+        }
+        return nullptr;
+    }
+
+    // Only meaningful from the consumer thread
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return tail_ == &stub_ && !stub_.next_.load(std::memory_order_acquire);
+    }
+
+private:
+    // Producers only touch the head, the consumer the tail and the stub
+    alignas(cache_line_size) std::atomic<node*> head_;
+    alignas(cache_line_size) node* tail_;
+    node stub_;
+};
+} // namespace br
+
+#endif // BR_IMPSC_QUEUE_H_
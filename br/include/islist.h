@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_ISLIST_H_
+#define BR_ISLIST_H_
+
+#include "ilist.h"
+
+#include <cstddef>
+#include <mutex>
+
+namespace br {
+
+// Intrusive singly linked list for pure FIFO/LIFO uses, like free lists and work
+// queues: the hook is a single pointer, a third of an ilist hook. Nodes can only be
+// taken from the front, there is no unlink from the middle and a node does not know
+// the list it is in, so nothing happens when a linked node is destroyed. Pushing to
+// the front and popping from the front makes it a stack, pushing to the back a queue.
+// Same MUTEX_LOCK and TAG parameters as ilist.
+template <typename T, typename MUTEX_LOCK=detail_::void_mutex, typename TAG=void>
+class islist {
+public:
+    class node {
+        friend class islist;
+
+    public:
+        const T* next() const noexcept { return static_cast<const T*>(next_); }
+
+    protected:
+        ~node() = default;
+
+    private:
+        node* next_{nullptr};
+    };
+
+    islist() noexcept = default;
+
+    islist(const islist&)            = delete;
+    islist& operator=(const islist&) = delete;
+
+    void push_front(node* n) noexcept
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        n->next_ = head_;
+        head_    = n;
+        if (!tail_) tail_ = n;
+        ++n_entries_;
+    }
+
+    void push_back(node* n) noexcept
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        n->next_ = nullptr;
+        if (tail_) tail_->next_ = n;
+        else head_ = n;
+        tail_ = n;
+        ++n_entries_;
+    }
+
+    T* pop_front() noexcept
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        auto*                       n = head_;
+        if (!n) return nullptr;
+
+        head_ = n->next_;
+        if (!head_) tail_ = nullptr;
+        n->next_ = nullptr;
+        --n_entries_;
+        return static_cast<T*>(n);
+    }
+
+    [[nodiscard]] T* front() const noexcept { return static_cast<T*>(head_); }
+    [[nodiscard]] T* back() const noexcept { return static_cast<T*>(tail_); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return n_entries_; }
+    [[nodiscard]] bool        empty() const noexcept { return n_entries_ == 0; }
+
+    // Appends every node of other to this list in O(1), taking each lock once
+    std::size_t splice(islist& other) noexcept
+    {
+        if (&other == this) return 0;
+        const detail_::pair_lock<MUTEX_LOCK> l(mutex_lck_, other.mutex_lck_);
+
+        const auto n = other.n_entries_;
+        if (!n) return 0;
+
+        if (tail_) tail_->next_ = other.head_;
+        else head_ = other.head_;
+        tail_ = other.tail_;
+        n_entries_ += n;
+
+        other.head_      = nullptr;
+        other.tail_      = nullptr;
+        other.n_entries_ = 0;
+        return n;
+    }
+
+    // Moves every node of this list to the back of other, see splice()
+    std::size_t drain_to(islist& other) noexcept { return other.splice(*this); }
+
+    void clear() noexcept
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        head_      = nullptr;
+        tail_      = nullptr;
+        n_entries_ = 0;
+    }
+
+    // Calls fn(T&) for every node, front to back, with the lock held
+    template <typename FN>
+    void for_each(FN fn)
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        for (auto* n = head_; n; n = n->next_) {
+            fn(*static_cast<T*>(n));
+        }
+    }
+
+private:
+    node*       head_{nullptr};
+    node*       tail_{nullptr};
+    std::size_t n_entries_{0};
+
+    MUTEX_LOCK mutex_lck_;
+};
+} // namespace br
+
+#endif // BR_ISLIST_H_
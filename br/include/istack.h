@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_ISTACK_H_
+#define BR_ISTACK_H_
+
+#include <atomic>
+
+namespace br {
+
+// Treiber's intrusive lock-free stack. Objects embed the node, as with ilist, so
+// pushing allocates nothing. push() is lock-free from any thread. pop() and pop_all()
+// must not run concurrently with each other: a single consumer makes pop() immune to
+// ABA, since only that thread can take a node off and push it back. pop_all() takes
+// the whole stack with one exchange, the cheapest way to drain it in batches.
+template <typename T>
+class istack {
+public:
+    class node {
+        friend class istack;
+
+    public:
+        // Next node of a chain returned by pop_all()
+        T* next() const noexcept { return static_cast<T*>(next_); }
+
+    protected:
+        ~node() = default;
+
+    private:
+        node* next_{nullptr};
+    };
+
+    istack() noexcept = default;
+
+    istack(const istack&)            = delete;
+    istack& operator=(const istack&) = delete;
+
+    void push(node* n) noexcept
+    {
+        auto* top = top_.load(std::memory_order_relaxed);
+        do {
+            n->next_ = top;
+        } while (!top_.compare_exchange_weak(top, n, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    T* pop() noexcept
+    {
+        auto* top = top_.load(std::memory_order_acquire);
+        while (top && !top_.compare_exchange_weak(top, top->next_, std::memory_order_acquire, std::memory_order_acquire)) {
+        }
+        return static_cast<T*>(top);
+    }
+
+    // Takes every node, the last pushed first, chained through node::next()
+    T* pop_all() noexcept
+    {
+        return static_cast<T*>(top_.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return !top_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<node*> top_{nullptr};
+};
+} // namespace br
+
+#endif // BR_ISTACK_H_
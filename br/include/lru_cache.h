@@ -0,0 +1,366 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_LRU_CACHE_H_
+#define BR_LRU_CACHE_H_
+
+#include "arch_info.h"
+#include "ilist.h"
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace br {
+
+// LRU moves an entry to the front of the recency list on every hit. CLOCK only marks
+// it as referenced, and gives marked entries a second chance when evicting, so a hit
+// does not touch the neighbours of the entry in the list.
+enum class cache_policy { lru, clock };
+
+struct cache_stats {
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t evictions;
+};
+
+// Intrusive cache of at most capacity entries. T derives from basic_lru_cache::node,
+// which holds the key and the recency hook, and the cache never allocates after
+// construction: the index is an open-addressing table of (hash, T*) pairs with linear
+// probing and backward shift deletion, sized for a load factor of at most 1/2.
+// Entries are owned by the user, who gets them back when they are evicted or erased.
+// Not thread-safe, see basic_sharded_lru_cache. The counters can be read from any
+// thread.
+template <typename T,
+          typename KEY,
+          cache_policy POLICY = cache_policy::lru,
+          typename HASH       = std::hash<KEY>,
+          typename KEY_EQUAL  = std::equal_to<KEY>>
+class basic_lru_cache {
+    using list = ilist<T, detail_::void_mutex, basic_lru_cache>;
+
+public:
+    using key_type = KEY;
+
+    class node: public list::node {
+        friend class basic_lru_cache;
+
+    public:
+        [[nodiscard]] const KEY& key() const noexcept { return key_; }
+
+    protected:
+        node()  = default;
+        ~node() = default;
+
+    private:
+        KEY  key_{};
+        bool referenced_{false};
+    };
+
+    explicit basic_lru_cache(std::size_t capacity)
+        : capacity_(capacity)
+        , mask_(std::bit_ceil(std::max<std::size_t>(2 * capacity, 2)) - 1)
+        , index_(mask_ + 1)
+    {
+        assert(capacity > 0);
+    }
+
+    basic_lru_cache(const basic_lru_cache&)            = delete;
+    basic_lru_cache& operator=(const basic_lru_cache&) = delete;
+
+    ~basic_lru_cache() { recency_.clear(); }
+
+    // The entry of key, or nullptr. A hit makes it the most recently used.
+    T* find(const KEY& key) noexcept
+    {
+        const auto h = hash_(key);
+        const auto i = lookup(h, key);
+        if (i == npos) {
+            bump(misses_);
+            return nullptr;
+        }
+
+        bump(hits_);
+        auto* e = index_[i].e;
+        touch(e);
+        return e;
+    }
+
+    // Inserts e under key as the most recently used entry. Returns the entry it pushed
+    // out: the one previously stored under key, or the least recently used one when the
+    // cache was full, or nullptr. e must not be in the cache.
+    T* insert(const KEY& key, T* e)
+    {
+        const auto h = hash_(key);
+        e->key_        = key;
+        e->referenced_ = false;
+
+        T* out = nullptr;
+        if (const auto i = lookup(h, key); i != npos) {
+            out = index_[i].e;
+            remove(i);
+        }
+        else if (recency_.size() == capacity_) {
+            out = evict();
+        }
+
+        add(h, e);
+        return out;
+    }
+
+    // Takes e out of the cache, false if it was not in it
+    bool erase(T* e) noexcept
+    {
+        const auto i = lookup(hash_(e->key_), e->key_);
+        if (i == npos || index_[i].e != e) return false;
+
+        remove(i);
+        return true;
+    }
+
+    // Takes the entry of key out of the cache and returns it, or nullptr
+    T* erase(const KEY& key) noexcept
+    {
+        const auto i = lookup(hash_(key), key);
+        if (i == npos) return nullptr;
+
+        auto* e = index_[i].e;
+        remove(i);
+        return e;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return recency_.size(); }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] cache_stats stats() const noexcept
+    {
+        return {hits_.load(std::memory_order_relaxed),
+                misses_.load(std::memory_order_relaxed),
+                evictions_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct slot {
+        std::size_t hash;
+        T*          e;
+    };
+
+    // Single writer: a plain increment, but tear-free for readers on other threads
+    static void bump(std::atomic<std::uint64_t>& c) noexcept
+    {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t lookup(std::size_t h, const KEY& key) const noexcept
+    {
+        for (auto i = h & mask_; index_[i].e; i = (i + 1) & mask_) {
+            if (index_[i].hash == h && equal_(index_[i].e->key_, key)) return i;
+        }
+        return npos;
+    }
+
+    void touch(T* e) noexcept
+    {
+        if constexpr (POLICY == cache_policy::lru) {
+            if (recency_.front() != e) {
+                static_cast<typename list::node*>(e)->unlink();
+                recency_.push_front(e);
+            }
+        }
+        else {
+            e->referenced_ = true;
+        }
+    }
+
+    void add(std::size_t h, T* e) noexcept
+    {
+        auto i = h & mask_;
+        while (index_[i].e) i = (i + 1) & mask_;
+        index_[i] = {h, e};
+        recency_.push_front(e);
+    }
+
+    // Empties index slot i, shifting back the entries of its probe sequence
+    void remove(std::size_t i) noexcept
+    {
+        static_cast<typename list::node*>(index_[i].e)->unlink();
+
+        for (auto j = (i + 1) & mask_; index_[j].e; j = (j + 1) & mask_) {
+            const auto home = index_[j].hash & mask_;
+            // Move j back to i unless its home lies cyclically in (i, j]
+            if (((j - home) & mask_) >= ((j - i) & mask_)) {
+                index_[i] = index_[j];
+                i         = j;
+            }
+        }
+        index_[i] = {0, nullptr};
+    }
+
+    T* evict() noexcept
+    {
+        auto* e = recency_.back();
+        if constexpr (POLICY == cache_policy::clock) {
+            // Second chance: referenced entries go back to the front, unmarked
+            while (e->referenced_) {
+                e->referenced_ = false;
+                static_cast<typename list::node*>(e)->unlink();
+                recency_.push_front(e);
+                e = recency_.back();
+            }
+        }
+
+        remove(lookup(hash_(e->key_), e->key_));
+        bump(evictions_);
+        return e;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+
+    std::vector<slot> index_;
+    list              recency_;
+
+    [[no_unique_address]] HASH      hash_;
+    [[no_unique_address]] KEY_EQUAL equal_;
+
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> evictions_{0};
+};
+
+template <typename T, typename KEY, typename HASH = std::hash<KEY>, typename KEY_EQUAL = std::equal_to<KEY>>
+using lru_cache = basic_lru_cache<T, KEY, cache_policy::lru, HASH, KEY_EQUAL>;
+
+template <typename T, typename KEY, typename HASH = std::hash<KEY>, typename KEY_EQUAL = std::equal_to<KEY>>
+using clock_cache = basic_lru_cache<T, KEY, cache_policy::clock, HASH, KEY_EQUAL>;
+
+// Lock-striped cache for concurrent use: keys are spread over n_shards independent
+// caches by the high bits of their hash, each behind its own MUTEX_LOCK. Entries found
+// are only handed out under the lock of their shard, through visit().
+template <typename T,
+          typename KEY,
+          cache_policy POLICY = cache_policy::lru,
+          typename MUTEX_LOCK = std::mutex,
+          typename HASH       = std::hash<KEY>,
+          typename KEY_EQUAL  = std::equal_to<KEY>>
+class basic_sharded_lru_cache {
+public:
+    using cache_type = basic_lru_cache<T, KEY, POLICY, HASH, KEY_EQUAL>;
+    using node       = typename cache_type::node;
+
+    // capacity is split evenly among the shards, n_shards must be a power of two
+    basic_sharded_lru_cache(std::size_t capacity, std::size_t n_shards)
+        : shift_(64 - std::countr_zero(n_shards))
+    {
+        assert(std::has_single_bit(n_shards) && "The number of shards must be a power of two");
+        shards_.reserve(n_shards);
+        for (std::size_t i = 0; i < n_shards; ++i) {
+            shards_.push_back(std::make_unique<shard>((capacity + n_shards - 1) / n_shards));
+        }
+    }
+
+    // Calls fn(T&) with the entry of key under the lock of its shard, false on a miss
+    template <typename FN>
+    bool visit(const KEY& key, FN&& fn)
+    {
+        auto&           s = shard_of(key);
+        std::lock_guard l(s.lock);
+        auto*           e = s.cache.find(key);
+        if (!e) return false;
+
+        fn(*e);
+        return true;
+    }
+
+    // See basic_lru_cache::insert(), the entry returned is no longer in the cache
+    T* insert(const KEY& key, T* e)
+    {
+        auto&           s = shard_of(key);
+        std::lock_guard l(s.lock);
+        return s.cache.insert(key, e);
+    }
+
+    T* erase(const KEY& key)
+    {
+        auto&           s = shard_of(key);
+        std::lock_guard l(s.lock);
+        return s.cache.erase(key);
+    }
+
+    [[nodiscard]] std::size_t size()
+    {
+        std::size_t n = 0;
+        for (auto& s : shards_) {
+            std::lock_guard l(s->lock);
+            n += s->cache.size();
+        }
+        return n;
+    }
+
+    [[nodiscard]] cache_stats stats() const noexcept
+    {
+        cache_stats total{0, 0, 0};
+        for (const auto& s : shards_) {
+            const auto st = s->cache.stats();
+            total.hits += st.hits;
+            total.misses += st.misses;
+            total.evictions += st.evictions;
+        }
+        return total;
+    }
+
+private:
+    struct alignas(cache_line_size) shard {
+        explicit shard(std::size_t capacity)
+            : cache(capacity)
+        {
+        }
+
+        MUTEX_LOCK lock;
+        cache_type cache;
+    };
+
+    shard& shard_of(const KEY& key) noexcept
+    {
+        // Mixed, since std::hash is often the identity, and the high bits taken as the
+        // low ones pick the index slot inside the shard
+        const auto h = static_cast<std::uint64_t>(HASH{}(key)) * 0x9e3779b97f4a7c15ULL;
+        return *shards_[shift_ == 64 ? 0 : h >> shift_];
+    }
+
+    const unsigned                      shift_;
+    std::vector<std::unique_ptr<shard>> shards_;
+};
+
+template <typename T, typename KEY, typename MUTEX_LOCK = std::mutex>
+using sharded_lru_cache = basic_sharded_lru_cache<T, KEY, cache_policy::lru, MUTEX_LOCK>;
+} // namespace br
+
+#endif // BR_LRU_CACHE_H_
@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_PROFILED_LOCK_H_
+#define BR_PROFILED_LOCK_H_
+
+#include "arch_info.h"
+#include "clock.h"
+#include "ilist.h"
+#include "thread_index.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <vector>
+
+namespace br {
+
+struct lock_profile_stats {
+    const void*   lock{nullptr};
+    const char*   name{nullptr};
+    std::uint64_t acquisitions{0};
+    std::uint64_t contended{0}; // Acquisitions that found the lock taken
+    std::uint64_t wait_ns{0};   // Time spent in L::lock() by contended acquisitions
+    std::uint64_t hold_ns{0};
+};
+
+namespace detail_ {
+// Counters of a profiled lock, registered in a process-wide list while it lives.
+// They are not per thread: threads add with relaxed atomics to one of n_stripes cache
+// line sized stripes picked by their thread index, shared by the threads whose indices
+// are equal modulo n_stripes. That keeps a lock's counters to a few cache lines however
+// many threads use it, while most threads still write lines no one else does.
+class lock_profile: public ilist<lock_profile, std::mutex>::node {
+public:
+    lock_profile();
+    ~lock_profile();
+
+    lock_profile(const lock_profile&)            = delete;
+    lock_profile& operator=(const lock_profile&) = delete;
+
+    void set_name(const char* name) noexcept { name_.store(name, std::memory_order_relaxed); }
+
+    [[nodiscard]] lock_profile_stats stats() const noexcept;
+    void                             reset() noexcept;
+
+protected:
+    struct alignas(cache_line_size) stripe {
+        std::atomic<std::uint64_t> acquisitions{0};
+        std::atomic<std::uint64_t> contended{0};
+        std::atomic<std::uint64_t> wait_ns{0};
+        std::atomic<std::uint64_t> hold_ns{0};
+    };
+
+    stripe& my_stripe() noexcept { return stripes_[thread_index() & (n_stripes - 1)]; }
+
+private:
+    static constexpr std::size_t n_stripes = 8;
+
+    stripe                   stripes_[n_stripes];
+    std::atomic<const char*> name_{nullptr};
+};
+} // namespace detail_
+
+// Wraps a lock with the lock()/unlock()/try_lock() shape and counts its acquisitions,
+// contention, wait and hold times, so it can be the MUTEX_LOCK of any container.
+// lock() tells contention apart with a single try_lock() and otherwise calls L::lock()
+// as is, so the wrapped lock keeps its own spinning, parking and fairness; the waits
+// inside it are only seen as time. Times come from tsc_clock.
+template <typename L>
+class basic_profiled_lock: public detail_::lock_profile {
+public:
+    using lock_type = L;
+
+    void lock()
+    {
+        if (lock_.try_lock()) {
+            my_stripe().acquisitions.fetch_add(1, std::memory_order_relaxed);
+            acquired_at_ = tsc_clock::now();
+            return;
+        }
+
+        const auto t0 = tsc_clock::now();
+        lock_.lock();
+        acquired_at_ = tsc_clock::now();
+
+        auto& s = my_stripe();
+        s.acquisitions.fetch_add(1, std::memory_order_relaxed);
+        s.contended.fetch_add(1, std::memory_order_relaxed);
+        s.wait_ns.fetch_add((acquired_at_ - t0).count(), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool try_lock()
+    {
+        if (!lock_.try_lock()) return false;
+        my_stripe().acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_at_ = tsc_clock::now();
+        return true;
+    }
+
+    void unlock()
+    {
+        const auto held = tsc_clock::now() - acquired_at_;
+        my_stripe().hold_ns.fetch_add(held.count(), std::memory_order_relaxed);
+        lock_.unlock();
+    }
+
+private:
+    L                     lock_;
+    tsc_clock::time_point acquired_at_; // Only touched by the owner
+};
+
+// What containers should take as MUTEX_LOCK: the profiled lock when the library is
+// built with BR_LOCK_PROFILING, the bare L otherwise
+#if defined(BR_LOCK_PROFILING)
+template <typename L>
+using profiled_lock = basic_profiled_lock<L>;
+#else
+template <typename L>
+using profiled_lock = L;
+#endif
+
+// Names a lock in the profile dumps. Does nothing for locks that are not profiled.
+template <typename L>
+void set_lock_name(L&, const char*) noexcept
+{
+}
+
+template <typename L>
+void set_lock_name(basic_profiled_lock<L>& l, const char* name) noexcept
+{
+    l.set_name(name);
+}
+
+// Statistics of every profiled lock alive
+[[nodiscard]] std::vector<lock_profile_stats> lock_profiles();
+
+// One line per profiled lock alive, the longest waited for first
+void dump_lock_profiles(std::ostream& os);
+} // namespace br
+
+#endif // BR_PROFILED_LOCK_H_
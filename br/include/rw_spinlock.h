@@ -0,0 +1,131 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_RW_SPINLOCK_H_
+#define BR_RW_SPINLOCK_H_
+
+#include "arch_info.h"
+#include "spinlock.h"
+#include "thread_index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace br {
+
+// Reader-writer spinlock with a distributed reader count: every reader increments a
+// counter on its own cache line, picked by its thread index, so readers never write
+// to a line another reader is using and read-side throughput scales with the cores.
+// Writers pay for it: they raise a flag, then wait for every counter to drain.
+// Writers are preferred, readers arriving while the flag is up wait for it to drop.
+// Meets the SharedLockable requirements, so it works with std::shared_lock.
+class rw_spinlock {
+public:
+    // n_slots is rounded up to a power of two. Threads beyond it share counters.
+    explicit rw_spinlock(std::size_t n_slots = std::thread::hardware_concurrency())
+        : slots_(std::make_unique<slot[]>(std::bit_ceil(std::max<std::size_t>(n_slots, 1))))
+        , slot_mask_(std::bit_ceil(std::max<std::size_t>(n_slots, 1)) - 1)
+    {
+    }
+
+    rw_spinlock(rw_spinlock&)             = delete;
+    rw_spinlock(rw_spinlock&&)            = delete;
+    rw_spinlock& operator=(rw_spinlock&)  = delete;
+    rw_spinlock& operator=(rw_spinlock&&) = delete;
+
+    void lock_shared() noexcept
+    {
+        auto&              s = my_slot();
+        detail_::backoff<> b;
+        while (!try_enter(s)) {
+            while (writer_.load(std::memory_order_relaxed)) b.pause_or_yield();
+        }
+    }
+
+    [[nodiscard]] bool try_lock_shared() noexcept { return try_enter(my_slot()); }
+
+    void unlock_shared() noexcept { my_slot().readers.fetch_sub(1, std::memory_order_release); }
+
+    void lock() noexcept
+    {
+        detail_::backoff<> b;
+        while (writer_.load(std::memory_order_relaxed) || writer_.exchange(true, std::memory_order_seq_cst)) {
+            b.pause_or_yield();
+        }
+        wait_for_readers();
+    }
+
+    [[nodiscard]] bool try_lock() noexcept
+    {
+        if (writer_.load(std::memory_order_relaxed) || writer_.exchange(true, std::memory_order_seq_cst)) {
+            return false;
+        }
+        for (std::size_t i = 0; i <= slot_mask_; ++i) {
+            if (slots_[i].readers.load(std::memory_order_seq_cst) != 0) {
+                writer_.store(false, std::memory_order_release);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void unlock() noexcept { writer_.store(false, std::memory_order_release); }
+
+private:
+    struct alignas(cache_line_size) slot {
+        std::atomic<std::uint32_t> readers{0};
+    };
+
+    slot& my_slot() noexcept { return slots_[detail_::thread_index() & slot_mask_]; }
+
+    // The increment and the load of the flag are sequentially consistent, as are the
+    // writer's store of the flag and its loads of the counters: at least one of both
+    // sees the other
+    bool try_enter(slot& s) noexcept
+    {
+        s.readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst)) return true;
+        s.readers.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    void wait_for_readers() noexcept
+    {
+        for (std::size_t i = 0; i <= slot_mask_; ++i) {
+            detail_::backoff<> b;
+            while (slots_[i].readers.load(std::memory_order_seq_cst) != 0) b.pause_or_yield();
+        }
+    }
+
+    alignas(cache_line_size) std::atomic<bool> writer_{false};
+
+    std::unique_ptr<slot[]> slots_;
+    const std::size_t       slot_mask_;
+};
+} // namespace br
+
+#endif // BR_RW_SPINLOCK_H_
@@ -0,0 +1,114 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_SEQLOCK_H_
+#define BR_SEQLOCK_H_
+
+#include "arch_info.h"
+#include "spinlock.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace br {
+
+// Sequence lock for a small trivially copyable value read far more often than it is
+// written. Readers never write shared memory: they copy the value and retry if a
+// writer ran meanwhile, which the sequence number (odd while a write is in progress)
+// tells them. Writers serialize on MUTEX_LOCK and never wait for readers.
+//
+// The value is kept as an array of relaxed atomic words, so torn copies that readers
+// throw away are not data races.
+template <typename T, typename MUTEX_LOCK = spinlock>
+class seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock values are copied byte by byte");
+
+public:
+    seqlock() noexcept
+        : seqlock(T{})
+    {
+    }
+
+    explicit seqlock(const T& v) noexcept { write_words(v); }
+
+    seqlock(const seqlock&)            = delete;
+    seqlock& operator=(const seqlock&) = delete;
+
+    [[nodiscard]] T load() const noexcept
+    {
+        detail_::backoff<> b;
+        for (;;) {
+            const auto s0 = seq_.load(std::memory_order_acquire);
+            if (!(s0 & 1)) {
+                std::array<std::uint64_t, n_words> copy;
+                for (std::size_t i = 0; i < n_words; ++i) copy[i] = words_[i].load(std::memory_order_relaxed);
+
+                // Orders the copy before the second read of the sequence
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == s0) {
+                    std::array<std::byte, sizeof(T)> bytes;
+                    std::memcpy(bytes.data(), copy.data(), sizeof(T));
+                    return std::bit_cast<T>(bytes);
+                }
+            }
+            b.pause_or_yield();
+        }
+    }
+
+    void store(const T& v) noexcept(noexcept(std::declval<MUTEX_LOCK&>().lock()))
+    {
+        std::lock_guard<MUTEX_LOCK> l(mutex_lck_);
+        const auto                  s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        // Orders the odd sequence before the new words
+        std::atomic_thread_fence(std::memory_order_release);
+        write_words(v);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // Number of completed writes
+    [[nodiscard]] std::uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    static constexpr std::size_t n_words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    void write_words(const T& v) noexcept
+    {
+        std::array<std::uint64_t, n_words> copy{};
+        std::memcpy(copy.data(), &v, sizeof(T));
+        for (std::size_t i = 0; i < n_words; ++i) words_[i].store(copy[i], std::memory_order_relaxed);
+    }
+
+    alignas(cache_line_size) std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, n_words>     words_;
+
+    MUTEX_LOCK mutex_lck_;
+};
+} // namespace br
+
+#endif // BR_SEQLOCK_H_
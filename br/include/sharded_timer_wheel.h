@@ -0,0 +1,298 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef BR_SHARDED_TIMER_WHEEL_H_
+#define BR_SHARDED_TIMER_WHEEL_H_
+
+#include "timer_wheel.h"
+#include "arch_info.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace br {
+namespace detail_ {
+// Vyukov's bounded queue restricted to a single consumer. Producers claim a cell with a
+// CAS on the enqueue position and publish it with the cell sequence number, the consumer
+// only needs loads and stores. Capacity must be a power of two.
+template <typename T>
+class mpsc_ring {
+public:
+    explicit mpsc_ring(std::size_t capacity)
+        : mask_(capacity - 1)
+        , cells_(new cell[capacity])
+    {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // False if the ring is full
+    bool try_push(const T& v) noexcept
+    {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto&      c   = cells_[pos & mask_];
+            const auto seq = c.seq.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (dif == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = v;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (dif < 0) {
+                return false;
+            }
+            else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Only from the consumer thread. False if the ring is empty
+    bool try_pop(T& v) noexcept
+    {
+        auto& c = cells_[dequeue_pos_ & mask_];
+        if (c.seq.load(std::memory_order_acquire) != dequeue_pos_ + 1) return false;
+
+        v = c.value;
+        c.seq.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+private:
+    struct cell {
+        std::atomic<std::size_t> seq;
+        T                        value;
+    };
+
+    const std::size_t       mask_;
+    std::unique_ptr<cell[]> cells_;
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(cache_line_size) std::size_t dequeue_pos_{0};
+};
+} // namespace detail_
+
+template <typename DURATION=std::chrono::duration<uint64_t>,
+          typename CLOCK=std::chrono::steady_clock>
+class basic_sharded_timer_wheel;
+
+using sharded_timer_wheel = basic_sharded_timer_wheel<>;
+
+// One unlocked timer wheel per CPU, each run by its own thread pinned to that CPU.
+// Other threads never touch a shard's wheel: publish() and cancel() go through a
+// lock-free inbox that the shard drains before every tick, and the entries expire on
+// the thread of the shard they were published to. Once published, an entry belongs to
+// that shard: while it is pending it must only be cancelled or republished through this
+// class and with the same shard index, since a shard thread touching an entry linked to
+// another shard's wheel would race with that shard.
+// A shard drains its inbox at the start of every slot, or as soon as a producer finds it
+// full, in which case publish() and cancel() fail and the caller decides when to retry.
+// The shard keeps using an entry until it expired or until cancel_and_wait() returned:
+// only then may it be destroyed. A cancel() that was only queued is not enough, the
+// entry would be unlinked (or expired) by the shard thread after it was freed.
+template <typename DURATION, typename CLOCK>
+class basic_sharded_timer_wheel {
+public:
+    using duration   = DURATION;
+    using time_point = typename CLOCK::time_point;
+    using wheel_type = basic_timer_wheel<detail_::void_mutex, DURATION, CLOCK>;
+
+    // One shard per CPU listed in cpus, or per CPU in the system if empty
+    explicit basic_sharded_timer_wheel(const duration        sd,
+                                       std::size_t           ns,
+                                       std::vector<unsigned> cpus           = {},
+                                       std::size_t           inbox_capacity = 4096)
+    {
+        if (cpus.empty()) {
+            const arch_info ai;
+            for (const auto& nn : ai.numa_nodes()) {
+                for (const auto& cpu : nn.cpus()) cpus.push_back(cpu.id());
+            }
+            if (cpus.empty()) {
+                for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i) cpus.push_back(i);
+            }
+        }
+
+        for (const auto cpu : cpus) {
+            if (cpu >= cpu_to_shard_.size()) cpu_to_shard_.resize(cpu + 1, cpus.size());
+            cpu_to_shard_[cpu] = shards_.size();
+            shards_.push_back(std::make_unique<shard>(sd, ns, inbox_capacity));
+        }
+
+        for (std::size_t i = 0; i < shards_.size(); ++i) {
+            shards_[i]->thread = std::jthread([this, i](std::stop_token st) { shards_[i]->run(std::move(st)); });
+            arch_info::set_cpu_affinity(shards_[i]->thread, cpus[i]);
+        }
+    }
+
+    ~basic_sharded_timer_wheel()
+    {
+        for (auto& s : shards_) s->thread.request_stop();
+        for (auto& s : shards_) s->thread.join();
+    }
+
+    basic_sharded_timer_wheel(const basic_sharded_timer_wheel&)            = delete;
+    basic_sharded_timer_wheel& operator=(const basic_sharded_timer_wheel&) = delete;
+
+    // Shard of the CPU this thread runs on right now. Pick it once per entry and keep
+    // using it for that entry, the thread may run elsewhere the next time.
+    [[nodiscard]] std::size_t local_shard() const noexcept
+    {
+        const auto cpu = arch_info::current_cpu();
+        return cpu < cpu_to_shard_.size() && cpu_to_shard_[cpu] < shards_.size() ? cpu_to_shard_[cpu]
+                                                                                   : cpu % shards_.size();
+    }
+
+    // Publishes e to shard idx, or reschedules it if already pending there. False if the
+    // inbox of the shard is full: the shard is woken up to drain it, try again later.
+    [[nodiscard]] bool publish(std::size_t idx, expirable* e, const time_point expirationTime) noexcept
+    {
+        return shards_[idx]->push({e, expirationTime, false});
+    }
+
+    // Asynchronous: the entry may still expire if its shard gets to it first. False if
+    // the inbox is full, as for publish().
+    [[nodiscard]] bool cancel(std::size_t idx, expirable* e) noexcept
+    {
+        return shards_[idx]->push({e, {}, true});
+    }
+
+    // Cancels e and waits for shard idx to be done with it: when this returns, e is not
+    // pending and not expiring, and requests queued for it before were handled, so it
+    // can be destroyed. The shard is woken up to handle the cancel right away. From the
+    // thread of the shard, in expire() for instance, the entry is unlinked directly.
+    void cancel_and_wait(std::size_t idx, expirable* e)
+    {
+        auto& s = *shards_[idx];
+        if (std::this_thread::get_id() == s.thread.get_id()) {
+            e->unlink();
+            return;
+        }
+
+        bool done = false;
+        while (!s.push({e, {}, true, &done})) std::this_thread::yield();
+        s.wake_up();
+
+        std::unique_lock<std::mutex> l(s.done_lck);
+        s.done_cv.wait(l, [&] { return done; });
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return shards_.size(); }
+
+private:
+    struct op {
+        expirable* e{nullptr};
+        time_point expiration{};
+        bool       cancel{false};
+        // Set by the shard once handled, under done_lck, for cancel_and_wait()
+        bool*      done{nullptr};
+    };
+
+    struct shard {
+        shard(const duration sd, std::size_t ns, std::size_t inbox_capacity)
+            : slot_duration(sd)
+            , start(CLOCK::now())
+            , wheel(sd, ns, start)
+            , inbox(std::bit_ceil(inbox_capacity))
+        {
+        }
+
+        bool push(const op& o) noexcept
+        {
+            if (inbox.try_push(o)) return true;
+
+            // Full: only then take the lock, to wake the shard before its next slot
+            wake_up();
+            return false;
+        }
+
+        void wake_up()
+        {
+            {
+                std::lock_guard<std::mutex> l(wake_lck);
+                wake = true;
+            }
+            wake_cv.notify_one();
+        }
+
+        // Sleeps until the next slot starts, or until a producer finds the inbox full
+        void run(std::stop_token st)
+        {
+            while (!st.stop_requested()) {
+                op o;
+                while (inbox.try_pop(o)) {
+                    if (o.cancel) o.e->unlink();
+                    else wheel.reschedule(o.e, o.expiration);
+
+                    if (o.done) {
+                        // The waiter owns done, it may go away as soon as the lock is released
+                        {
+                            std::lock_guard<std::mutex> l(done_lck);
+                            *o.done = true;
+                        }
+                        done_cv.notify_all();
+                    }
+                }
+
+                const auto now = CLOCK::now();
+                wheel.check_expiration(now);
+
+                // Start of the next slot, counted from the clock and not from the number of
+                // wake-ups, which a producer finding the inbox full can cause at any time
+                const auto slots     = (now - start) / slot_duration + 1;
+                const auto next_slot = start + std::chrono::duration_cast<typename CLOCK::duration>(slots * slot_duration);
+
+                std::unique_lock<std::mutex> l(wake_lck);
+                wake_cv.wait_until(l, st, next_slot, [this] { return wake; });
+                wake = false;
+            }
+        }
+
+        const duration          slot_duration;
+        const time_point        start;
+        wheel_type              wheel;
+        detail_::mpsc_ring<op>  inbox;
+
+        std::mutex                  wake_lck;
+        std::condition_variable_any wake_cv;
+        bool                        wake{false};
+
+        std::mutex              done_lck;
+        std::condition_variable done_cv;
+
+        std::jthread thread;
+    };
+
+    std::vector<std::unique_ptr<shard>> shards_;
+    std::vector<std::size_t>            cpu_to_shard_;
+};
+} // namespace br
+
+#endif // BR_SHARDED_TIMER_WHEEL_H_
@@ -0,0 +1,283 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_SLAB_TIMER_WHEEL_H_
+#define BR_SLAB_TIMER_WHEEL_H_
+
+#include "timer_wheel.h"
+
+#include <cassert>
+#include <limits>
+
+namespace br {
+
+// Timer wheel keeping its timers in a slab instead of intrusive lists. Timers are
+// 32 bits indices into struct-of-arrays storage, and every slot holds two parallel
+// arrays with the expiry ticks and the indices of its timers. Visiting a slot streams
+// through its tick array, first counting the due timers (a loop the compiler
+// vectorizes) and then compacting the slot in place, so a busy slot costs a couple of
+// sequential passes rather than a cache miss per timer.
+//
+// Timers carry a 64 bits user value handed back when they expire, and are identified
+// by a handle with a generation, so a stale handle never cancels a reused timer.
+// Not thread-safe. Otherwise it behaves like basic_timer_wheel: absolute ticks, an
+// occupancy bitmap to skip empty slots and catch-ups of at most one revolution.
+template <typename DURATION=std::chrono::duration<uint64_t>, typename CLOCK=std::chrono::steady_clock>
+class basic_slab_timer_wheel {
+public:
+    using clock      = CLOCK;
+    using duration   = DURATION;
+    using time_point = typename CLOCK::time_point;
+    using timer_id   = std::uint64_t;
+
+    explicit basic_slab_timer_wheel(const duration   sd,
+                                    std::size_t      ns,
+                                    const time_point st)
+        : start_time_(st)
+        , slot_duration_(sd)
+        , slot_mask_(std::has_single_bit(ns) ? ns - 1 : 0)
+        , slots_(ns)
+        , occupancy_(ns)
+    {
+    }
+
+    // Reserves room for n timers, so publishing up to n does not allocate in the slab
+    void reserve(std::size_t n)
+    {
+        assert(n <= max_timers && "Timer indices are 32 bits");
+        tick_.reserve(n);
+        pos_.reserve(n);
+        generation_.reserve(n);
+        data_.reserve(n);
+        free_.reserve(n);
+    }
+
+    timer_id publish(const time_point expirationTime, std::uint64_t data)
+    {
+        const auto idx  = allocate();
+        const auto tick = std::max(tick_of(expirationTime), c_tick_);
+
+        tick_[idx] = tick;
+        data_[idx] = data;
+
+        const auto s    = slot_index(tick);
+        auto&      slot = slots_[s];
+        pos_[idx]       = static_cast<std::uint32_t>(slot.ids.size());
+        slot.ticks.push_back(tick);
+        slot.ids.push_back(idx);
+        occupancy_.set(s);
+
+        return (timer_id{generation_[idx]} << 32) | idx;
+    }
+
+    // False if the timer already expired or was cancelled
+    bool cancel(timer_id id)
+    {
+        if (!valid(id)) return false;
+
+        const auto idx = static_cast<std::uint32_t>(id);
+        if (pos_[idx] != expiring) {
+            auto& slot = slots_[slot_index(tick_[idx])];
+            remove(slot, pos_[idx]);
+        }
+
+        release(idx);
+        return true;
+    }
+
+    [[nodiscard]] bool pending(timer_id id) const noexcept { return valid(id); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return generation_.size() - free_.size(); }
+
+    // Calls fn(data) for every expired timer. The timers are taken out of the slots
+    // before the first call, so fn can publish and cancel timers freely.
+    template <typename FN>
+    void check_expiration(const time_point now, FN&& fn)
+    {
+        const auto target = tick_of(now);
+        if (target <= c_tick_) return;
+
+        const auto first = slot_index(c_tick_);
+        const auto count = std::min<std::uint64_t>(target - c_tick_, slots_.size());
+        c_tick_          = target;
+
+        expired_.clear();
+        for_each_occupied(first, count, [&](std::size_t idx) {
+            auto& slot = slots_[idx];
+            collect_due(slot, target);
+            if (slot.ids.empty()) occupancy_.reset(idx);
+        });
+
+        for (const auto id : expired_) {
+            // Cancelled by an earlier callback of this same batch
+            if (!valid(id)) continue;
+
+            const auto idx = static_cast<std::uint32_t>(id);
+            const auto d   = data_[idx];
+            release(idx);
+            fn(d);
+        }
+    }
+
+    // Same contract as basic_timer_wheel::next_expiration()
+    [[nodiscard]] std::optional<time_point> next_expiration() const noexcept
+    {
+        const auto first = slot_index(c_tick_);
+        const auto end   = slots_.size();
+
+        auto distance = occupancy_.find_next(first, end) - first;
+        if (distance == end - first) {
+            const auto idx = occupancy_.find_next(0, first);
+            if (idx == first) return std::nullopt;
+            distance += idx;
+        }
+
+        return start_time_ + (c_tick_ + distance + 1) * slot_duration_;
+    }
+
+private:
+    static constexpr std::uint32_t expiring   = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t   max_timers = std::numeric_limits<std::uint32_t>::max();
+
+    struct slot_type {
+        std::vector<std::uint64_t> ticks;
+        std::vector<std::uint32_t> ids;
+    };
+
+    [[nodiscard]] bool valid(timer_id id) const noexcept
+    {
+        const auto idx = static_cast<std::uint32_t>(id);
+        return idx < generation_.size() && generation_[idx] == static_cast<std::uint32_t>(id >> 32);
+    }
+
+    std::uint32_t allocate()
+    {
+        if (!free_.empty()) {
+            const auto idx = free_.back();
+            free_.pop_back();
+            return idx;
+        }
+
+        assert(generation_.size() < max_timers && "Timer indices are 32 bits");
+        tick_.push_back(0);
+        pos_.push_back(0);
+        generation_.push_back(0);
+        data_.push_back(0);
+        return static_cast<std::uint32_t>(generation_.size() - 1);
+    }
+
+    void release(std::uint32_t idx)
+    {
+        ++generation_[idx];
+        free_.push_back(idx);
+    }
+
+    // Swaps the last timer of the slot into position p
+    void remove(slot_type& slot, std::uint32_t p) noexcept
+    {
+        const auto last = slot.ids.size() - 1;
+        if (p != last) {
+            slot.ticks[p]     = slot.ticks[last];
+            slot.ids[p]       = slot.ids[last];
+            pos_[slot.ids[p]] = p;
+        }
+        slot.ticks.pop_back();
+        slot.ids.pop_back();
+    }
+
+    // Moves the due timers of the slot to expired_
+    void collect_due(slot_type& slot, std::uint64_t target)
+    {
+        const auto           n     = slot.ticks.size();
+        const std::uint64_t* ticks = slot.ticks.data();
+
+        std::size_t due = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            due += ticks[i] < target;
+        }
+        if (!due) return;
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto idx = slot.ids[i];
+            if (slot.ticks[i] < target) {
+                pos_[idx] = expiring;
+                expired_.push_back((timer_id{generation_[idx]} << 32) | idx);
+            }
+            else {
+                slot.ticks[kept] = slot.ticks[i];
+                slot.ids[kept]   = idx;
+                pos_[idx]        = static_cast<std::uint32_t>(kept);
+                ++kept;
+            }
+        }
+        slot.ticks.resize(kept);
+        slot.ids.resize(kept);
+    }
+
+    template <typename FN>
+    void for_each_occupied(std::size_t first, std::size_t count, FN&& fn)
+    {
+        const auto end = std::min(first + count, slots_.size());
+        for (auto idx = occupancy_.find_next(first, end); idx < end; idx = occupancy_.find_next(idx + 1, end)) {
+            fn(idx);
+        }
+
+        const auto wrapped = first + count - end;
+        for (auto idx = occupancy_.find_next(0, wrapped); idx < wrapped; idx = occupancy_.find_next(idx + 1, wrapped)) {
+            fn(idx);
+        }
+    }
+
+    [[nodiscard]] std::uint64_t tick_of(const time_point t) const noexcept
+    {
+        return t > start_time_ ? static_cast<std::uint64_t>((t - start_time_) / slot_duration_) : 0;
+    }
+
+    [[nodiscard]] std::size_t slot_index(std::uint64_t tick) const noexcept
+    {
+        return slot_mask_ ? tick & slot_mask_ : tick % slots_.size();
+    }
+
+    std::uint64_t    c_tick_{0};
+    const time_point start_time_;
+
+    const duration      slot_duration_;
+    const std::uint64_t slot_mask_;
+
+    std::vector<slot_type>      slots_;
+    detail_::slot_bitmap<false> occupancy_;
+
+    // Struct-of-arrays slab, indexed by timer
+    std::vector<std::uint64_t> tick_;
+    std::vector<std::uint32_t> pos_;
+    std::vector<std::uint32_t> generation_;
+    std::vector<std::uint64_t> data_;
+    std::vector<std::uint32_t> free_;
+
+    std::vector<timer_id> expired_;
+};
+
+using slab_timer_wheel = basic_slab_timer_wheel<>;
+} // namespace br
+
+#endif // BR_SLAB_TIMER_WHEEL_H_
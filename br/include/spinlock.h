@@ -25,10 +25,53 @@
 
 
 #include <atomic>
+#include <cstdint>
 #include <thread>
 #include <cassert>
 
 namespace br {
+namespace detail_ {
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(i386) || defined(__i386__) || defined(__i386) || defined(_M_IX86)
+    __asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Bounded exponential backoff: every pause() spins twice as long as the previous one,
+// up to MAX_SPINS
+template <unsigned MAX_SPINS = 1024>
+class backoff {
+public:
+    void pause() noexcept
+    {
+        for (unsigned i = 0; i < spins_; ++i) cpu_relax();
+        if (spins_ < MAX_SPINS) spins_ <<= 1;
+    }
+
+    // Once saturated, gives the CPU away instead: the thread being waited for may need it
+    void pause_or_yield() noexcept
+    {
+        if (saturated()) std::this_thread::yield();
+        else pause();
+    }
+
+    [[nodiscard]] bool saturated() const noexcept { return spins_ >= MAX_SPINS; }
+
+private:
+    unsigned spins_{1};
+};
+
+// Blocks while *word == expected, or until woken. May return spuriously.
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept;
+void futex_wake_one(std::atomic<std::uint32_t>& word) noexcept;
+} // namespace detail_
+
+// Test-and-test-and-set spinlock: waiters spin reading the lock word, which stays
+// shared in their caches, and only try the CAS when it looks free, backing off
+// exponentially after every failed attempt. The word holds the id of the owner.
 class spinlock {
 public:
     spinlock() noexcept             = default;
@@ -39,47 +82,95 @@ public:
 
     void lock() noexcept
     {
-        auto expected = static_cast<std::thread::id>(0);
-        while (!l_.compare_exchange_weak(expected,
-                                         std::this_thread::get_id(),
-                                         std::memory_order_release,
-                                         std::memory_order_acquire)) {
-            expected = static_cast<std::thread::id>(0);
-#if defined(__x86_64__) || defined(_M_X64) || defined(i386) || defined(__i386__) || defined(__i386) || defined(_M_IX86)
-            __asm ("pause");
-#endif
-         }
+        const auto        self = std::this_thread::get_id();
+        detail_::backoff<> b;
+        for (;;) {
+            auto expected = std::thread::id();
+            if (l_.load(std::memory_order_relaxed) == expected &&
+                l_.compare_exchange_weak(expected, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            b.pause();
+        }
     }
 
     void unlock() noexcept
     {
-        auto       expected    = std::this_thread::get_id();
-        const bool same_thread = l_.compare_exchange_strong(expected,
-                                                            static_cast<std::thread::id>(0),
-                                                            std::memory_order_release,
-                                                            std::memory_order_acquire);
-        assert(
-            same_thread &&
-            "This thread is trying to unlock a non-locked spinlock or locked by another thread");
+        assert(l_.load(std::memory_order_relaxed) == std::this_thread::get_id() &&
+               "This thread is trying to unlock a non-locked spinlock or locked by another thread");
+        l_.store(std::thread::id(), std::memory_order_release);
     }
 
 
     [[nodiscard]] bool try_lock() noexcept
     {
-        auto expected = static_cast<std::thread::id>(0);
-        return !l_.compare_exchange_strong(expected,
-                                           std::this_thread::get_id(),
-                                           std::memory_order_release,
-                                           std::memory_order_relaxed);
+        auto expected = std::thread::id();
+        return l_.load(std::memory_order_relaxed) == expected &&
+               l_.compare_exchange_strong(expected,
+                                          std::this_thread::get_id(),
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
     }
 
 private:
-    std::atomic<std::thread::id> l_{static_cast<std::thread::id>(0)};
+    std::atomic<std::thread::id> l_{std::thread::id()};
 
     // Please note:
     static_assert(std::atomic<std::thread::id>::is_always_lock_free,
                   "Thread::id must be a real basic atomic to use this implementation");
 };
+
+// Spins like spinlock for a short while, then yields the CPU a few times and finally
+// parks the thread on a futex, so waiters stop burning timeslices when the owner has
+// been descheduled. The uncontended lock and unlock are a single atomic operation.
+class adaptive_mutex {
+public:
+    adaptive_mutex() noexcept                   = default;
+    adaptive_mutex(adaptive_mutex&)             = delete;
+    adaptive_mutex(adaptive_mutex&&)            = delete;
+    adaptive_mutex& operator=(adaptive_mutex&)  = delete;
+    adaptive_mutex& operator=(adaptive_mutex&&) = delete;
+
+    void lock() noexcept
+    {
+        std::uint32_t expected = unlocked;
+        if (!state_.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            lock_slow();
+        }
+        owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        assert(owner_.load(std::memory_order_relaxed) == std::this_thread::get_id() &&
+               "This thread is trying to unlock a non-locked mutex or locked by another thread");
+        owner_.store(std::thread::id(), std::memory_order_relaxed);
+        if (state_.exchange(unlocked, std::memory_order_release) == contended) detail_::futex_wake_one(state_);
+    }
+
+    [[nodiscard]] bool try_lock() noexcept
+    {
+        std::uint32_t expected = unlocked;
+        if (!state_.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return false;
+        }
+        owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    static constexpr std::uint32_t unlocked  = 0;
+    static constexpr std::uint32_t locked    = 1;
+    static constexpr std::uint32_t contended = 2; // Locked, and some thread may be parked
+
+    static constexpr unsigned max_spins  = 256;
+    static constexpr unsigned max_yields = 8;
+
+    void lock_slow() noexcept;
+
+    std::atomic<std::uint32_t>   state_{unlocked};
+    std::atomic<std::thread::id> owner_{std::thread::id()};
+};
 } // namespace br
 
 #endif /* BR_SPINLOCK_H_ */
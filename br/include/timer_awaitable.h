@@ -0,0 +1,211 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_TIMER_AWAITABLE_H_
+#define BR_TIMER_AWAITABLE_H_
+
+#include <chrono>
+#include <coroutine>
+#include <type_traits>
+#include <utility>
+
+namespace br {
+namespace detail_ {
+// Wheel entry embedded in an awaiter, which calls owner->fire() when it expires.
+// Wheels of virtual entries get a derived entry, wheels of callback entries store
+// the owner pointer in the callable. Either way it lives in the coroutine frame.
+template <typename ENTRY, typename OWNER, bool VIRTUAL = std::is_polymorphic_v<ENTRY>>
+class awaiter_entry final: public ENTRY {
+public:
+    void bind(OWNER* owner) noexcept { owner_ = owner; }
+
+    ENTRY* get() noexcept { return this; }
+
+    void expire() override { owner_->fire(); }
+
+private:
+    OWNER* owner_{nullptr};
+};
+
+template <typename ENTRY, typename OWNER>
+class awaiter_entry<ENTRY, OWNER, false> {
+public:
+    void bind(OWNER* owner) noexcept
+    {
+        entry_.set([owner]() { owner->fire(); });
+    }
+
+    ENTRY* get() noexcept { return &entry_; }
+
+private:
+    ENTRY entry_;
+};
+} // namespace detail_
+
+// Awaiters suspending a coroutine on a timer wheel. The timer is a member of the
+// awaiter, so it is part of the coroutine frame and suspending allocates nothing.
+// Coroutines are resumed from check_expiration() on the thread running the wheel,
+// which is also the thread that must await them and cancel them.
+
+// co_await sleep_until(wheel, t) resumes the coroutine once t has expired. cancel()
+// resumes it right away.
+template <typename WHEEL>
+class sleep_awaiter {
+public:
+    using time_point = typename WHEEL::time_point;
+
+    sleep_awaiter(WHEEL& wheel, const time_point expirationTime) noexcept
+        : wheel_(wheel)
+        , expiration_(expirationTime)
+    {
+    }
+
+    // Only while not suspended, the timer is not moved along
+    sleep_awaiter(sleep_awaiter&& o) noexcept
+        : wheel_(o.wheel_)
+        , expiration_(o.expiration_)
+    {
+    }
+
+    sleep_awaiter(const sleep_awaiter&)            = delete;
+    sleep_awaiter& operator=(const sleep_awaiter&) = delete;
+    sleep_awaiter& operator=(sleep_awaiter&&)      = delete;
+
+    // A coroutine destroyed while sleeping takes its timer out of the wheel
+    ~sleep_awaiter() { entry_.get()->unlink(); }
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> h) noexcept
+    {
+        handle_ = h;
+        entry_.bind(this);
+        wheel_.publish(entry_.get(), expiration_);
+    }
+
+    void await_resume() noexcept { entry_.get()->unlink(); }
+
+    void cancel()
+    {
+        if (!entry_.get()->linked()) return;
+
+        entry_.get()->unlink();
+        handle_.resume();
+    }
+
+private:
+    friend detail_::awaiter_entry<typename WHEEL::entry_type, sleep_awaiter>;
+
+    void fire() { handle_.resume(); }
+
+    WHEEL&                  wheel_;
+    const time_point        expiration_;
+    std::coroutine_handle<> handle_;
+
+    detail_::awaiter_entry<typename WHEEL::entry_type, sleep_awaiter> entry_;
+};
+
+template <typename WHEEL>
+[[nodiscard]] sleep_awaiter<WHEEL> sleep_until(WHEEL& wheel, const typename WHEEL::time_point expirationTime) noexcept
+{
+    return {wheel, expirationTime};
+}
+
+template <typename WHEEL, typename REP, typename PERIOD>
+[[nodiscard]] sleep_awaiter<WHEEL> sleep_for(WHEEL& wheel, const std::chrono::duration<REP, PERIOD> d)
+{
+    return {wheel, WHEEL::clock::now() + d};
+}
+
+// co_await with_timeout(wheel, op, t) awaits op, calling op.cancel() if it has not
+// completed by t. The operation is expected to resume the coroutine promptly when
+// cancelled, and to report it in its own result. When op completes first the timer
+// is taken out of the wheel. OP is an awaiter with a cancel() member, an lvalue is
+// kept by reference and an rvalue is moved into the timeout awaiter.
+template <typename WHEEL, typename OP>
+class timeout_awaiter {
+public:
+    using time_point = typename WHEEL::time_point;
+
+    timeout_awaiter(WHEEL& wheel, OP&& op, const time_point expirationTime) noexcept
+        : wheel_(wheel)
+        , op_(std::forward<OP>(op))
+        , expiration_(expirationTime)
+    {
+    }
+
+    timeout_awaiter(const timeout_awaiter&)            = delete;
+    timeout_awaiter& operator=(const timeout_awaiter&) = delete;
+
+    ~timeout_awaiter() { entry_.get()->unlink(); }
+
+    [[nodiscard]] bool await_ready() { return op_.await_ready(); }
+
+    template <typename PROMISE>
+    auto await_suspend(std::coroutine_handle<PROMISE> h)
+    {
+        entry_.bind(this);
+        wheel_.publish(entry_.get(), expiration_);
+
+        using result = decltype(op_.await_suspend(h));
+        if constexpr (std::is_same_v<result, bool>) {
+            const bool suspended = op_.await_suspend(h);
+            if (!suspended) entry_.get()->unlink();
+            return suspended;
+        }
+        else {
+            return op_.await_suspend(h);
+        }
+    }
+
+    decltype(auto) await_resume()
+    {
+        entry_.get()->unlink();
+        return op_.await_resume();
+    }
+
+private:
+    friend detail_::awaiter_entry<typename WHEEL::entry_type, timeout_awaiter>;
+
+    void fire() { op_.cancel(); }
+
+    WHEEL&           wheel_;
+    OP               op_;
+    const time_point expiration_;
+
+    detail_::awaiter_entry<typename WHEEL::entry_type, timeout_awaiter> entry_;
+};
+
+template <typename WHEEL, typename OP>
+[[nodiscard]] timeout_awaiter<WHEEL, OP> with_timeout(WHEEL& wheel, OP&& op, const typename WHEEL::time_point expirationTime)
+{
+    return {wheel, std::forward<OP>(op), expirationTime};
+}
+
+template <typename WHEEL, typename OP, typename REP, typename PERIOD>
+[[nodiscard]] timeout_awaiter<WHEEL, OP> with_timeout(WHEEL& wheel, OP&& op, const std::chrono::duration<REP, PERIOD> d)
+{
+    return {wheel, std::forward<OP>(op), WHEEL::clock::now() + d};
+}
+} // namespace br
+
+#endif // BR_TIMER_AWAITABLE_H_
@@ -0,0 +1,297 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_TIMER_QUEUE_H_
+#define BR_TIMER_QUEUE_H_
+
+#include "timer_wheel.h"
+
+#include <mutex>
+
+namespace br {
+
+using timer_queue    = basic_timer_queue<>;
+using ts_timer_queue = basic_timer_queue<std::mutex>;
+
+// Priority queue of timers with exact deadlines, for sparse timers needing a precision
+// finer than any reasonable wheel slot. It takes the same entries as basic_timer_wheel
+// and keeps them in a 4-ary min-heap of (deadline, entry) pairs: comparisons never
+// dereference an entry, the four children of a node are adjacent in memory and the heap
+// is half as deep as a binary one. Publish, reschedule and cancel are O(log n). Entries
+// expire once now reaches their deadline, rather than at the end of a slot.
+//
+// Entries in the queue are not linked to any list: cancel them with cancel(), not
+// unlink(), and cancel them before destroying them.
+template <typename MUTEX_LOCK, typename CLOCK, typename ENTRY>
+class basic_timer_queue {
+public:
+    using clock      = CLOCK;
+    using time_point = typename CLOCK::time_point;
+    using entry_type = ENTRY;
+
+    basic_timer_queue() = default;
+
+    basic_timer_queue(const basic_timer_queue&)            = delete;
+    basic_timer_queue& operator=(const basic_timer_queue&) = delete;
+
+    void reserve(std::size_t n)
+    {
+        std::lock_guard l(lock_);
+        heap_.reserve(n);
+    }
+
+    // Publishing an entry already in the queue moves it to the new deadline
+    void publish(ENTRY* e, const time_point expirationTime)
+    {
+        std::lock_guard l(lock_);
+        if (const auto i = position(e); i != npos) {
+            const auto earlier = expirationTime < heap_[i].deadline;
+            heap_[i].deadline  = expirationTime;
+            if (earlier) sift_up(i);
+            else sift_down(i);
+            return;
+        }
+
+        heap_.push_back({expirationTime, e});
+        sift_up(heap_.size() - 1);
+    }
+
+    void reschedule(ENTRY* e, const time_point expirationTime) { publish(e, expirationTime); }
+
+    // False if the entry was not in the queue
+    bool cancel(ENTRY* e) noexcept
+    {
+        std::lock_guard l(lock_);
+        const auto      i = position(e);
+        if (i == npos) return false;
+
+        remove(i);
+        return true;
+    }
+
+    [[nodiscard]] bool pending(const ENTRY* e) noexcept
+    {
+        std::lock_guard l(lock_);
+        return position(e) != npos;
+    }
+
+    // Expires, in deadline order, every entry whose deadline is not after now. The due
+    // entries are all taken out under one acquisition of the lock first, then expired
+    // with the queue unlocked: an entry that expire() publishes again at or before now
+    // waits for the next call instead of keeping this one going, and cancelling an
+    // entry already taken out comes too late.
+    void check_expiration(const time_point now)
+    {
+        std::vector<ENTRY*> due;
+        {
+            std::lock_guard l(lock_);
+            if (heap_.empty() || now < heap_.front().deadline) return;
+
+            // Reuses the buffer of the previous pass
+            due.swap(spare_);
+            do {
+                due.push_back(heap_.front().e);
+                remove(0);
+            } while (!heap_.empty() && !(now < heap_.front().deadline));
+        }
+
+        for (auto* e : due) e->expire();
+
+        due.clear();
+        std::lock_guard l(lock_);
+        if (due.capacity() > spare_.capacity()) spare_.swap(due);
+    }
+
+    // Exact deadline of the first entry to expire
+    [[nodiscard]] std::optional<time_point> next_expiration() noexcept
+    {
+        std::lock_guard l(lock_);
+        if (heap_.empty()) return std::nullopt;
+        return heap_.front().deadline;
+    }
+
+    [[nodiscard]] std::size_t size() noexcept
+    {
+        std::lock_guard l(lock_);
+        return heap_.size();
+    }
+
+private:
+    static constexpr std::size_t npos  = static_cast<std::size_t>(-1);
+    static constexpr std::size_t arity = 4;
+
+    struct item {
+        time_point deadline;
+        ENTRY*     e;
+    };
+
+    // The position is only trusted if the heap agrees, which also tells apart entries
+    // that were never published
+    [[nodiscard]] std::size_t position(const ENTRY* e) const noexcept
+    {
+        const auto i = static_cast<std::size_t>(e->expiry_tick_);
+        return i < heap_.size() && heap_[i].e == e ? i : npos;
+    }
+
+    void set(std::size_t i, const item& it) noexcept
+    {
+        heap_[i]           = it;
+        it.e->expiry_tick_ = i;
+    }
+
+    void remove(std::size_t i) noexcept
+    {
+        auto* e = heap_[i].e;
+
+        const auto last = heap_.back();
+        heap_.pop_back();
+        if (i < heap_.size()) {
+            const auto earlier = last.deadline < heap_[i].deadline;
+            set(i, last);
+            if (earlier) sift_up(i);
+            else sift_down(i);
+        }
+
+        e->expiry_tick_ = npos;
+    }
+
+    void sift_up(std::size_t i) noexcept
+    {
+        const auto it = heap_[i];
+        while (i > 0) {
+            const auto parent = (i - 1) / arity;
+            if (!(it.deadline < heap_[parent].deadline)) break;
+            set(i, heap_[parent]);
+            i = parent;
+        }
+        set(i, it);
+    }
+
+    void sift_down(std::size_t i) noexcept
+    {
+        const auto it = heap_[i];
+        const auto n  = heap_.size();
+        for (;;) {
+            const auto first = i * arity + 1;
+            if (first >= n) break;
+
+            // Smallest of the (up to four) adjacent children
+            auto       child = first;
+            const auto last  = std::min(first + arity, n);
+            for (auto c = first + 1; c < last; ++c) {
+                if (heap_[c].deadline < heap_[child].deadline) child = c;
+            }
+
+            if (!(heap_[child].deadline < it.deadline)) break;
+            set(i, heap_[child]);
+            i = child;
+        }
+        set(i, it);
+    }
+
+    MUTEX_LOCK          lock_;
+    std::vector<item>   heap_;
+    std::vector<ENTRY*> spare_;
+};
+
+// A timer queue for the timers due within precise_horizon of the last
+// check_expiration(), where they expire at their exact deadline, and a timer wheel for
+// the rest, where they expire at the end of their slot. Entries published to the wheel
+// stay there, so the precision of a timer is decided when it is published.
+template <typename MUTEX_LOCK=detail_::void_mutex,
+          typename DURATION=std::chrono::duration<uint64_t>,
+          typename CLOCK=std::chrono::steady_clock,
+          typename ENTRY=basic_expirable<MUTEX_LOCK>>
+class basic_hybrid_timer_queue {
+public:
+    using clock      = CLOCK;
+    using duration   = DURATION;
+    using time_point = typename CLOCK::time_point;
+    using entry_type = ENTRY;
+
+    basic_hybrid_timer_queue(const duration                 sd,
+                             std::size_t                    ns,
+                             const time_point               st,
+                             const typename clock::duration precise_horizon)
+        : wheel_(sd, ns, st)
+        , precise_horizon_(precise_horizon)
+        , now_(st.time_since_epoch().count())
+    {
+    }
+
+    // Publishing a pending entry moves it, to the other side if need be. The heap and
+    // the wheel both keep their bookkeeping in the entry, so it is first taken out of
+    // the side it leaves.
+    void publish(ENTRY* e, const time_point expirationTime)
+    {
+        const time_point now{typename clock::duration(now_.load(std::memory_order_relaxed))};
+        if (expirationTime - now < precise_horizon_) {
+            e->unlink();
+            queue_.publish(e, expirationTime);
+        }
+        else {
+            queue_.cancel(e);
+            wheel_.reschedule(e, expirationTime);
+        }
+    }
+
+    void reschedule(ENTRY* e, const time_point expirationTime) { publish(e, expirationTime); }
+
+    bool cancel(ENTRY* e) noexcept
+    {
+        if (e->linked()) {
+            e->unlink();
+            return true;
+        }
+        return queue_.cancel(e);
+    }
+
+    void check_expiration(const time_point now)
+    {
+        now_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+        wheel_.check_expiration(now);
+        queue_.check_expiration(now);
+    }
+
+    [[nodiscard]] std::optional<time_point> next_expiration() noexcept
+    {
+        const auto w = wheel_.next_expiration();
+        const auto q = queue_.next_expiration();
+        if (w && q) return std::min(*w, *q);
+        return w ? w : q;
+    }
+
+private:
+    using rep = typename clock::duration::rep;
+
+    basic_timer_wheel<MUTEX_LOCK, DURATION, CLOCK, ENTRY> wheel_;
+    basic_timer_queue<MUTEX_LOCK, CLOCK, ENTRY>           queue_;
+
+    const typename clock::duration precise_horizon_;
+    std::atomic<rep>               now_;
+};
+
+using hybrid_timer_queue    = basic_hybrid_timer_queue<>;
+using ts_hybrid_timer_queue = basic_hybrid_timer_queue<std::mutex>;
+} // namespace br
+
+#endif // BR_TIMER_QUEUE_H_
@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_TIMER_SNAPSHOT_H_
+#define BR_TIMER_SNAPSHOT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace br {
+
+// Snapshot file of pending timers: a header followed by count fixed size records,
+// in native byte order and laid out so the file can be mapped and read in place.
+// Deadlines are nanoseconds since the epoch of the clock of the wheel that saved them.
+struct timer_snapshot_header {
+    static constexpr std::uint32_t magic_value   = 0x57545242; // "BRTW"
+    static constexpr std::uint32_t version_value = 1;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t count;
+    std::int64_t  saved_at;
+    std::uint64_t reserved;
+};
+
+struct timer_snapshot_record {
+    std::int64_t  deadline;
+    std::uint64_t key;
+};
+
+static_assert(sizeof(timer_snapshot_header) == 32 && sizeof(timer_snapshot_record) == 16);
+
+// Read-only view of a snapshot file, memory mapped where the platform allows it.
+// Throws std::system_error if the file cannot be read and std::runtime_error if it
+// is not a snapshot of this version.
+class timer_snapshot {
+public:
+    explicit timer_snapshot(const std::filesystem::path& path);
+    ~timer_snapshot();
+
+    timer_snapshot(const timer_snapshot&)            = delete;
+    timer_snapshot& operator=(const timer_snapshot&) = delete;
+
+    [[nodiscard]] std::chrono::nanoseconds saved_at() const noexcept
+    {
+        return std::chrono::nanoseconds(header().saved_at);
+    }
+
+    [[nodiscard]] std::span<const timer_snapshot_record> records() const noexcept
+    {
+        return {reinterpret_cast<const timer_snapshot_record*>(data_ + sizeof(timer_snapshot_header)),
+                static_cast<std::size_t>(header().count)};
+    }
+
+private:
+    void unmap() noexcept;
+
+    [[nodiscard]] const timer_snapshot_header& header() const noexcept
+    {
+        return *reinterpret_cast<const timer_snapshot_header*>(data_);
+    }
+
+    const std::byte*       data_{nullptr};
+    std::size_t            size_{0};
+    std::vector<std::byte> buffer_;
+};
+
+// Writes the snapshot to a temporary file renamed over path, so a crash never leaves
+// a truncated snapshot behind. On POSIX systems the file is synced before the rename and
+// its directory after it, so that also holds across a power loss; elsewhere only a crash
+// of the process is covered. Throws std::system_error on failure.
+void write_timer_snapshot(const std::filesystem::path&           path,
+                          std::chrono::nanoseconds               saved_at,
+                          std::span<const timer_snapshot_record> records);
+} // namespace br
+
+#endif // BR_TIMER_SNAPSHOT_H_
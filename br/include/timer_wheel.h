@@ -24,10 +24,93 @@
 #define BR_TIMER_WHEEL_H_
 
 #include "ilist.h"
+#include "timer_snapshot.h"
+#include "timer_wheel_stats.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 namespace br {
+namespace detail_ {
+// One bit per wheel slot, set while the slot may hold entries. Bits are set after
+// linking into the slot and only cleared by the thread running the wheel, so a set
+// bit can be stale (the entry was unlinked) but a non-empty slot never has it clear.
+template <bool CONCURRENT>
+class slot_bitmap {
+public:
+    explicit slot_bitmap(std::size_t n)
+        : words_((n + 63) / 64)
+    {
+    }
+
+    void set(std::size_t i) noexcept
+    {
+        const auto bit = std::uint64_t{1} << (i & 63);
+        if constexpr (CONCURRENT) {
+            if (!(words_[i >> 6].load(std::memory_order_relaxed) & bit)) {
+                words_[i >> 6].fetch_or(bit, std::memory_order_release);
+            }
+        }
+        else {
+            words_[i >> 6] |= bit;
+        }
+    }
+
+    void reset(std::size_t i) noexcept
+    {
+        const auto bit = std::uint64_t{1} << (i & 63);
+        if constexpr (CONCURRENT) {
+            words_[i >> 6].fetch_and(~bit, std::memory_order_acq_rel);
+        }
+        else {
+            words_[i >> 6] &= ~bit;
+        }
+    }
+
+    // First set bit in [from, last), or last if there is none
+    [[nodiscard]] std::size_t find_next(std::size_t from, std::size_t last) const noexcept
+    {
+        if (from >= last) return last;
+
+        auto w    = from >> 6;
+        auto bits = load(w) & (~std::uint64_t{0} << (from & 63));
+        while (!bits) {
+            if (++w << 6 >= last) return last;
+            bits = load(w);
+        }
+
+        const auto i = (w << 6) + std::countr_zero(bits);
+        return i < last ? i : last;
+    }
+
+private:
+    [[nodiscard]] std::uint64_t load(std::size_t w) const noexcept
+    {
+        if constexpr (CONCURRENT) {
+            return words_[w].load(std::memory_order_acquire);
+        }
+        else {
+            return words_[w];
+        }
+    }
+
+    using word = std::conditional_t<CONCURRENT, std::atomic<std::uint64_t>, std::uint64_t>;
+    std::vector<word> words_;
+};
+} // namespace detail_
+
+template <typename DERIVED, typename MUTEX_LOCK=detail_::void_mutex>
+class basic_timer_entry;
+
 template <typename MUTEX_LOCK=detail_::void_mutex>
 class basic_expirable;
 
@@ -37,18 +120,70 @@ using ts_expirable = basic_expirable<std::mutex>;
 template <typename MUTEX_LOCK>
 using basic_expirables_list = ilist<basic_expirable<MUTEX_LOCK>, MUTEX_LOCK>;
 
-template <typename MUTEX_LOCK=detail_::void_mutex>
+// DURATION is the type of the slot duration, so its period is the finest resolution the
+// wheel can work with. CLOCK only provides the time_point type, the wheel never reads it.
+// ENTRY is the type of the entries, basic_expirable or a final basic_timer_entry.
+// STATS is the statistics policy, see timer_wheel_stats.h.
+template <typename MUTEX_LOCK=detail_::void_mutex,
+          typename DURATION=std::chrono::duration<uint64_t>,
+          typename CLOCK=std::chrono::steady_clock,
+          typename ENTRY=basic_expirable<MUTEX_LOCK>,
+          typename STATS=no_timer_wheel_stats>
 class basic_timer_wheel;
 
 using timer_wheel    = basic_timer_wheel<>;
 using ts_timer_wheel = basic_timer_wheel<std::mutex>;
 
+template <typename MUTEX_LOCK=detail_::void_mutex,
+          typename DURATION=std::chrono::duration<uint64_t>,
+          typename CLOCK=std::chrono::steady_clock,
+          typename ENTRY=basic_expirable<MUTEX_LOCK>>
+class basic_hierarchical_timer_wheel;
+
+template <typename MUTEX_LOCK=detail_::void_mutex,
+          typename CLOCK=std::chrono::steady_clock,
+          typename ENTRY=basic_expirable<MUTEX_LOCK>>
+class basic_timer_queue;
+
 using time_point = std::chrono::time_point<std::chrono::steady_clock>;
 
-template <typename MUTEX_LOCK>
-class basic_expirable: public basic_expirables_list<MUTEX_LOCK>::node {
-    friend class basic_timer_wheel<MUTEX_LOCK>;
+// Base of the timer wheel entries, without virtual functions. DERIVED provides a
+// non-virtual expire() that the wheels call directly, so a wheel of DERIVED entries
+// has no indirect calls and its entries carry no vtable pointer:
+//
+//     struct session final: br::basic_timer_entry<session> { void expire(); };
+//     br::basic_timer_wheel<br::detail_::void_mutex, std::chrono::seconds,
+//                           std::chrono::steady_clock, session> tw(...);
+template <typename DERIVED, typename MUTEX_LOCK>
+class basic_timer_entry: public ilist<DERIVED, MUTEX_LOCK>::node {
+    template <typename, typename, typename, typename, typename>
+    friend class basic_timer_wheel;
+    template <typename, typename, typename, typename>
+    friend class basic_hierarchical_timer_wheel;
+    template <typename, typename, typename>
+    friend class basic_timer_queue;
 
+public:
+    using list = ilist<DERIVED, MUTEX_LOCK>;
+
+protected:
+    basic_timer_entry() noexcept                                    = default;
+    ~basic_timer_entry()                                            = default;
+    basic_timer_entry(const basic_timer_entry&) noexcept            = default;
+    basic_timer_entry& operator=(const basic_timer_entry&) noexcept = default;
+    basic_timer_entry(basic_timer_entry&&) noexcept                 = default;
+    basic_timer_entry& operator=(basic_timer_entry&&) noexcept      = default;
+
+private:
+    // Absolute tick of the wheel at which this expires. touch() may move it forward
+    // from another thread while the wheel is traversing, hence the atomic_ref alignment.
+    // In a timer queue, which keeps deadlines in its heap, the position in the heap.
+    alignas(std::atomic_ref<std::uint64_t>::required_alignment) std::uint64_t expiry_tick_{0};
+};
+
+// Entry with a virtual expire(), for wheels mixing different kinds of timers
+template <typename MUTEX_LOCK>
+class basic_expirable: public basic_timer_entry<basic_expirable<MUTEX_LOCK>, MUTEX_LOCK> {
 public:
     basic_expirable() noexcept                                  = default;
     virtual ~basic_expirable()                                  = default;
@@ -58,67 +193,398 @@ public:
     basic_expirable& operator=(basic_expirable&&) noexcept      = default;
 
     virtual void expire() = 0;
+};
+
+// Entry running a callable stored inline, with no heap allocation. The callable has to
+// be trivially copyable (a lambda capturing pointers or references, for instance) and
+// fit in SIZE bytes. The call goes through a plain function pointer.
+template <typename MUTEX_LOCK=detail_::void_mutex, std::size_t SIZE=2 * sizeof(void*)>
+class basic_callback_expirable final
+    : public basic_timer_entry<basic_callback_expirable<MUTEX_LOCK, SIZE>, MUTEX_LOCK> {
+public:
+    basic_callback_expirable() noexcept = default;
+
+    template <typename FN>
+    explicit basic_callback_expirable(FN fn) noexcept
+    {
+        set(fn);
+    }
+
+    template <typename FN>
+    void set(FN fn) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<FN>, "The callable must be trivially copyable");
+        static_assert(sizeof(FN) <= SIZE && alignof(FN) <= alignof(std::max_align_t),
+                      "The callable does not fit in the entry");
+
+        ::new (static_cast<void*>(storage_)) FN(fn);
+        invoke_ = [](void* p) { (*static_cast<FN*>(p))(); };
+    }
+
+    void expire()
+    {
+        if (invoke_) invoke_(storage_);
+    }
 
 private:
-    std::size_t n_loops_{0};
+    void (*invoke_)(void*){nullptr};
+    alignas(std::max_align_t) unsigned char storage_[SIZE];
 };
 
-template <typename MUTEX_LOCK>
+using callback_expirable    = basic_callback_expirable<>;
+using ts_callback_expirable = basic_callback_expirable<std::mutex>;
+
+template <typename MUTEX_LOCK, typename DURATION, typename CLOCK, typename ENTRY, typename STATS>
 class basic_timer_wheel {
 public:
-    explicit basic_timer_wheel(std::chrono::duration<uint64_t> sd,
-                               std::size_t                     ns,
-                               const time_point                st) noexcept
-        : c_idx_(0)
+    using clock      = CLOCK;
+    using duration   = DURATION;
+    using time_point = typename CLOCK::time_point;
+    using entry_type = ENTRY;
+    using entry_list = ilist<ENTRY, MUTEX_LOCK>;
+    using stats_type = STATS;
+
+    explicit basic_timer_wheel(const duration   sd,
+                               std::size_t      ns,
+                               const time_point st) noexcept
+        : c_tick_(0)
         , start_time_(st)
         , slot_duration_(sd)
-        , one_loop_duration_(slot_duration_ * ns)
+        , slot_mask_(std::has_single_bit(ns) ? ns - 1 : 0)
         , slots_(ns)
+        , occupancy_(ns)
     {
     }
 
     void check_expiration(const time_point now)
     {
-        const auto elapsed         = now - start_time_;
-        auto       nSlotsTraversed = elapsed / slot_duration_;
-        start_time_ += (nSlotsTraversed * slot_duration_);
+        check_expiration(now, [](entry_list&) {});
+    }
 
-        while (nSlotsTraversed--) {
-            for (auto it = slots_[c_idx_].begin(); it != slots_[c_idx_].end();) {
-                const auto nIt = std::next(it);
-                if ((*it).n_loops_ == 0) {
-                    (*it).expire();
-                    (*it).unlink();
-                }
-                else {
-                    --(*it).n_loops_;
+    // Work is proportional to the number of occupied slots in the elapsed time: empty
+    // slots are skipped with the occupancy bitmap, and a jump of one revolution or more
+    // visits every occupied slot once. In that case entries expire in slot order rather
+    // than strictly in deadline order.
+    //
+    // The due entries of each visited slot are spliced into a batch list owned by the
+    // wheel under a single acquisition of the slot lock. The list is then handed to
+    // executor(batch) with no slot lock held, so the executor can take entries out with
+    // pop_front() or splice_if() to run them elsewhere. Whatever is left in the batch
+    // when it returns is expired right away on this thread. The batch outlives the call
+    // so that an entry cancelled from another thread while it is being moved can
+    // always follow it there; only one thread may call check_expiration() at a time.
+    template <typename EXECUTOR>
+    void check_expiration(const time_point now, EXECUTOR&& executor)
+    {
+        const auto c_tick = c_tick_.load(std::memory_order_relaxed);
+        const auto target = tick_of(now);
+        if (target <= c_tick) return;
+
+        const auto first = slot_index(c_tick);
+        const auto count = std::min<std::uint64_t>(target - c_tick, slots_.size());
+        c_tick_.store(target, std::memory_order_relaxed);
+        // Pairs with the fence in publish_tick(): a publisher that still saw the old
+        // tick linked its entry before the slot is swept below
+        if constexpr (concurrent) std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto& batch = batch_;
+        for_each_occupied(first, count, [&](std::size_t idx) {
+            occupancy_.reset(idx);
+
+            auto&       slot    = slots_[idx];
+            std::size_t visited = 0;
+            std::size_t due     = 0;
+            std::size_t kept    = 0;
+            batch.splice_if(slot, [&](ENTRY& e) {
+                const auto tick = load_expiry_tick(e);
+                if constexpr (STATS::enabled) {
+                    ++visited;
+                    if (tick < target) {
+                        ++due;
+                        stats_.on_due(lateness_ns(now, tick));
+                    }
                 }
-                it = nIt;
+                // Due, or touched since it was placed here
+                const bool take = tick < target || slot_index(tick) != idx;
+                kept += !take;
+                return take;
+            });
+            stats_.on_slot(visited, due);
+
+            // Counted under the slot lock, entries published since set the bit themselves
+            if (kept) occupancy_.set(idx);
+        });
+
+        if (batch.empty()) return;
+
+        auto& touched = touched_;
+        touched.splice_if(batch, [&](ENTRY& e) { return load_expiry_tick(e) >= target; });
+        while (auto* e = touched.pop_front()) {
+            place(e, slot_index(load_expiry_tick(*e)));
+        }
+
+        executor(batch);
+        while (auto* e = batch.pop_front()) {
+            if constexpr (STATS::enabled) {
+                const auto t0 = std::chrono::steady_clock::now();
+                e->expire();
+                const auto t1 = std::chrono::steady_clock::now();
+                stats_.on_expire(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
             }
-            c_idx_ = (c_idx_ + 1) % slots_.size();
+            else {
+                e->expire();
+            }
+        }
+    }
+
+    // Earliest time at which check_expiration() may expire something, or nothing if the
+    // wheel is empty. It is the end of the first occupied slot, found with the occupancy
+    // bitmap without looking at the entries, so it is never later than the earliest
+    // deadline but can be earlier when that slot only holds entries of later revolutions.
+    [[nodiscard]] std::optional<time_point> next_expiration() const noexcept
+    {
+        const auto c_tick = c_tick_.load(std::memory_order_relaxed);
+        const auto first  = slot_index(c_tick);
+        const auto end    = slots_.size();
+
+        auto distance = occupancy_.find_next(first, end) - first;
+        if (distance == end - first) {
+            const auto idx = occupancy_.find_next(0, first);
+            if (idx == first) return std::nullopt;
+            distance += idx;
         }
+
+        return start_time_ + (c_tick + distance + 1) * slot_duration_;
+    }
+
+    // Deadlines already due expire on the next check_expiration()
+    void publish(ENTRY* e, const time_point expirationTime) noexcept
+    {
+        publish_tick(e, std::max(tick_of(expirationTime), c_tick_.load(std::memory_order_relaxed)));
     }
 
-    void publish(basic_expirable<MUTEX_LOCK>* e,
-                 const time_point             expirationTime) noexcept
+    // Publishes an entry that may fire up to slack after its deadline. As with the Linux
+    // timer slack, the deadline is moved to the coarsest tick boundary (the one with the
+    // most trailing zero bits) inside the window, so entries with overlapping windows
+    // end up together in a few dense slots instead of spreading over many sparse ones.
+    // A negative slack counts as none.
+    template <typename REP, typename PERIOD>
+    void publish(ENTRY* e, const time_point expirationTime, const std::chrono::duration<REP, PERIOD> slack) noexcept
     {
-        const auto timeDiff = expirationTime - start_time_;
-        const auto nSlots   = timeDiff / slot_duration_;
-        const auto pIdx     = (c_idx_ + nSlots) % slots_.size();
+        const auto tick = std::max(tick_of(expirationTime), c_tick_.load(std::memory_order_relaxed));
+        // Clamped before dividing, the slot duration may have an unsigned rep
+        const auto window = slack > slack.zero() ? static_cast<std::uint64_t>(slack / slot_duration_) : 0;
+        publish_tick(e, coalesce(tick, tick + window));
+    }
 
-        e->n_loops_ = timeDiff / one_loop_duration_;
+    // Moves a pending entry to the slot of its new deadline right away, or publishes
+    // it if it was not pending.
+    void reschedule(ENTRY* e, const time_point expirationTime) noexcept
+    {
+        e->unlink();
+        publish(e, expirationTime);
+    }
 
-        slots_[pIdx].push_back(e);
+    template <typename REP, typename PERIOD>
+    void reschedule(ENTRY* e, const time_point expirationTime, const std::chrono::duration<REP, PERIOD> slack) noexcept
+    {
+        e->unlink();
+        publish(e, expirationTime, slack);
     }
 
+    // Lazy reschedule for deadlines that only move forward, like idle timeouts: the
+    // new deadline is just recorded in the entry, which is moved to its new slot when
+    // its current slot comes up. Earlier deadlines fall back to reschedule().
+    // A touch racing with the expiration of the entry may be lost.
+    void touch(ENTRY* e, const time_point expirationTime) noexcept
+    {
+        const auto tick = tick_of(expirationTime);
+        if (!e->linked() || tick < load_expiry_tick(*e)) {
+            reschedule(e, expirationTime);
+            return;
+        }
+
+        store_expiry_tick(*e, tick);
+    }
+
+    // Saves the pending entries to a snapshot file, each with its deadline and the key
+    // returned by key(const ENTRY&). Slots are saved one at a time under their lock, an
+    // entry published meanwhile may or may not be saved.
+    template <typename KEY>
+    void save(const std::filesystem::path& path, const time_point now, KEY&& key)
+    {
+        std::vector<timer_snapshot_record> records;
+        for (auto& slot : slots_) {
+            slot.for_each([&](ENTRY& e) {
+                const auto deadline = start_time_ + load_expiry_tick(e) * slot_duration_;
+                records.push_back({nanoseconds_since_epoch(deadline), key(static_cast<const ENTRY&>(e))});
+            });
+        }
+
+        write_timer_snapshot(path, std::chrono::nanoseconds(nanoseconds_since_epoch(now)), records);
+    }
+
+    // Publishes the entries of a snapshot written by save(): resolve(key) returns the
+    // entry of every saved key, or nullptr to drop it. Deadlines keep the distance they
+    // had to the time the snapshot was saved, now counting from now. Entries are
+    // bucketed by slot first and linked with one lock acquisition per slot, rather than
+    // one per entry. Entries already pending, and the repeats of a key saved more than
+    // once, are left as they are. Returns the number of entries published.
+    template <typename RESOLVE>
+    std::size_t load(const std::filesystem::path& path, const time_point now, RESOLVE&& resolve)
+    {
+        const timer_snapshot snapshot(path);
+        const auto           saved_at = snapshot.saved_at();
+        const auto           c_tick   = c_tick_.load(std::memory_order_relaxed);
+
+        std::vector<std::pair<std::size_t, ENTRY*>> placed;
+        std::vector<std::size_t>                    first(slots_.size() + 1, 0);
+        std::unordered_set<ENTRY*>                  seen;
+        placed.reserve(snapshot.records().size());
+        seen.reserve(snapshot.records().size());
+        for (const auto& r : snapshot.records()) {
+            ENTRY* e = resolve(r.key);
+            // The tick of a pending entry must keep matching the slot it is in
+            if (!e || e->linked() || !seen.insert(e).second) continue;
+
+            const auto remaining = std::chrono::nanoseconds(r.deadline) - saved_at;
+            const auto tick =
+                std::max(tick_of(std::chrono::time_point_cast<typename time_point::duration>(now + remaining)), c_tick);
+            store_expiry_tick(*e, tick);
+
+            const auto idx = slot_index(tick);
+            placed.emplace_back(idx, e);
+            ++first[idx + 1];
+        }
+
+        // Counting sort by slot
+        for (std::size_t i = 1; i < first.size(); ++i) first[i] += first[i - 1];
+        std::vector<ENTRY*> sorted(placed.size());
+        auto                next = first;
+        for (const auto& [idx, e] : placed) sorted[next[idx]++] = e;
+
+        std::size_t n = 0;
+        for (std::size_t idx = 0; idx < slots_.size(); ++idx) {
+            if (first[idx] == first[idx + 1]) continue;
+
+            const auto linked =
+                slots_[idx].push_back_batch(sorted.begin() + first[idx], sorted.begin() + first[idx + 1]);
+            if (linked) occupancy_.set(idx);
+            for (std::size_t i = 0; i < linked; ++i) stats_.on_publish();
+            n += linked;
+        }
+        return n;
+    }
+
+    [[nodiscard]] STATS&       stats() noexcept { return stats_; }
+    [[nodiscard]] const STATS& stats() const noexcept { return stats_; }
+
 private:
-    size_t     c_idx_;
-    time_point start_time_;
+    static constexpr bool concurrent = !std::is_same_v<MUTEX_LOCK, detail_::void_mutex>;
+
+    void publish_tick(ENTRY* e, std::uint64_t tick) noexcept
+    {
+        store_expiry_tick(*e, tick);
+        place(e, slot_index(tick));
+
+        // On a locked wheel, check_expiration() may have moved past tick while this was
+        // placing the entry, and already swept its slot. The entry then moves to the slot
+        // of the current tick, which the next pass sweeps first, unless the sweep took it.
+        if constexpr (concurrent) {
+            for (;;) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const auto c_tick = c_tick_.load(std::memory_order_relaxed);
+                if (tick >= c_tick || !slots_[slot_index(tick)].erase(e)) break;
+
+                tick = c_tick;
+                store_expiry_tick(*e, tick);
+                place(e, slot_index(tick));
+            }
+        }
+        stats_.on_publish();
+    }
+
+    // Tick in [first, last] with the most trailing zero bits: clear in last every bit
+    // below the highest one where first and last differ.
+    [[nodiscard]] static constexpr std::uint64_t coalesce(std::uint64_t first, std::uint64_t last) noexcept
+    {
+        if (last <= first) return first;
+
+        const auto mask = (std::uint64_t{1} << (std::bit_width(first ^ last) - 1)) - 1;
+        return last & ~mask;
+    }
+
+    void place(ENTRY* e, std::size_t idx) noexcept
+    {
+        slots_[idx].push_back(e);
+        occupancy_.set(idx);
+    }
+
+    // Calls fn(idx) for every occupied slot in the circular range [first, first + count)
+    template <typename FN>
+    void for_each_occupied(std::size_t first, std::size_t count, FN&& fn)
+    {
+        const auto end = std::min(first + count, slots_.size());
+        for (auto idx = occupancy_.find_next(first, end); idx < end; idx = occupancy_.find_next(idx + 1, end)) {
+            fn(idx);
+        }
+
+        const auto wrapped = first + count - end;
+        for (auto idx = occupancy_.find_next(0, wrapped); idx < wrapped; idx = occupancy_.find_next(idx + 1, wrapped)) {
+            fn(idx);
+        }
+    }
+
+    static std::uint64_t load_expiry_tick(ENTRY& e) noexcept
+    {
+        return std::atomic_ref<std::uint64_t>(e.expiry_tick_).load(std::memory_order_relaxed);
+    }
+
+    static void store_expiry_tick(ENTRY& e, std::uint64_t tick) noexcept
+    {
+        std::atomic_ref<std::uint64_t>(e.expiry_tick_).store(tick, std::memory_order_relaxed);
+    }
+
+    // Slots elapsed from the start of the wheel to t. Ticks only depend on the start
+    // time, so publishers never see a tick and a start time out of sync.
+    [[nodiscard]] std::uint64_t tick_of(const time_point t) const noexcept
+    {
+        return t > start_time_ ? static_cast<std::uint64_t>((t - start_time_) / slot_duration_) : 0;
+    }
+
+    template <typename TIME_POINT>
+    static std::int64_t nanoseconds_since_epoch(const TIME_POINT t) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    // Time from the end of the slot of tick, which is already over, to now
+    [[nodiscard]] std::uint64_t lateness_ns(const time_point now, std::uint64_t tick) const noexcept
+    {
+        const auto late = now - (start_time_ + (tick + 1) * slot_duration_);
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(late).count());
+    }
+
+    // With a power of two number of slots this is a mask
+    [[nodiscard]] std::size_t slot_index(std::uint64_t tick) const noexcept
+    {
+        return slot_mask_ ? tick & slot_mask_ : tick % slots_.size();
+    }
+
+    std::atomic<std::uint64_t> c_tick_;
+    const time_point           start_time_;
+
+    const duration      slot_duration_;
+    const std::uint64_t slot_mask_;
+
+    std::vector<entry_list>          slots_;
+    detail_::slot_bitmap<concurrent> occupancy_;
 
-    const std::chrono::duration<uint64_t> slot_duration_;
-    const std::chrono::duration<uint64_t> one_loop_duration_;
+    // Used by check_expiration() only, members rather than locals for unlink()
+    entry_list batch_;
+    entry_list touched_;
 
-    std::vector<ilist<basic_expirable<MUTEX_LOCK>, MUTEX_LOCK>> slots_;
+    [[no_unique_address]] STATS stats_;
 };
 } // namespace br
 
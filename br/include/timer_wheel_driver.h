@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef BR_TIMER_WHEEL_DRIVER_H_
+#define BR_TIMER_WHEEL_DRIVER_H_
+
+#if defined(__linux__)
+
+#include "timer_wheel.h"
+
+#include <limits>
+#include <thread>
+
+namespace br {
+namespace detail_ {
+// A timerfd and an eventfd multiplexed with epoll: wait() sleeps until the timer
+// expires or somebody calls wake().
+class timer_waiter {
+public:
+    timer_waiter();
+    ~timer_waiter();
+
+    timer_waiter(const timer_waiter&)            = delete;
+    timer_waiter& operator=(const timer_waiter&) = delete;
+
+    // Relative to now, the timer is disarmed with a zero duration
+    void arm(std::chrono::nanoseconds) noexcept;
+    void wait() noexcept;
+    void wake() noexcept;
+
+private:
+    void close_all() noexcept;
+
+    int epoll_fd_;
+    int timer_fd_;
+    int event_fd_;
+};
+} // namespace detail_
+
+// Runs check_expiration() of a locked timer wheel from its own thread, which sleeps on a
+// timerfd armed for next_expiration() and uses no CPU while there is nothing to expire.
+// Timers must be published through the driver (or followed by a call to wake()) so the
+// thread can be woken up when they expire before the time it is sleeping until.
+template <typename WHEEL>
+class timer_wheel_driver {
+public:
+    using time_point = typename WHEEL::time_point;
+
+    explicit timer_wheel_driver(WHEEL& wheel)
+        : wheel_(wheel)
+        , thread_([this](std::stop_token st) { run(st); })
+    {
+    }
+
+    ~timer_wheel_driver()
+    {
+        thread_.request_stop();
+        waiter_.wake();
+    }
+
+    timer_wheel_driver(const timer_wheel_driver&)            = delete;
+    timer_wheel_driver& operator=(const timer_wheel_driver&) = delete;
+
+    template <typename EXPIRABLE>
+    void publish(EXPIRABLE* e, const time_point expirationTime) noexcept
+    {
+        wheel_.publish(e, expirationTime);
+        wake_if_earlier(expirationTime);
+    }
+
+    template <typename EXPIRABLE, typename SLACK>
+    void publish(EXPIRABLE* e, const time_point expirationTime, const SLACK slack) noexcept
+    {
+        wheel_.publish(e, expirationTime, slack);
+        wake_if_earlier(expirationTime);
+    }
+
+    template <typename EXPIRABLE>
+    void reschedule(EXPIRABLE* e, const time_point expirationTime) noexcept
+    {
+        wheel_.reschedule(e, expirationTime);
+        wake_if_earlier(expirationTime);
+    }
+
+    template <typename EXPIRABLE, typename SLACK>
+    void reschedule(EXPIRABLE* e, const time_point expirationTime, const SLACK slack) noexcept
+    {
+        wheel_.reschedule(e, expirationTime, slack);
+        wake_if_earlier(expirationTime);
+    }
+
+    // Deadlines that only move forward never need to wake the thread
+    template <typename EXPIRABLE>
+    void touch(EXPIRABLE* e, const time_point expirationTime) noexcept
+    {
+        wheel_.touch(e, expirationTime);
+        wake_if_earlier(expirationTime);
+    }
+
+    void wake() noexcept { waiter_.wake(); }
+
+private:
+    using rep = typename time_point::rep;
+
+    // While the thread is awake it recomputes the deadline anyway
+    static constexpr rep awake = std::numeric_limits<rep>::min();
+    static constexpr rep idle  = std::numeric_limits<rep>::max();
+
+    void wake_if_earlier(const time_point expirationTime) noexcept
+    {
+        // Pairs with the fence in run(): either the thread sees the new entry when it
+        // recomputes its deadline, or this sees the deadline the thread sleeps until.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (expirationTime.time_since_epoch().count() < sleeping_until_.load(std::memory_order_relaxed)) {
+            waiter_.wake();
+        }
+    }
+
+    void run(const std::stop_token& st)
+    {
+        while (!st.stop_requested()) {
+            sleeping_until_.store(awake, std::memory_order_relaxed);
+            wheel_.check_expiration(WHEEL::clock::now());
+
+            const auto next = wheel_.next_expiration();
+            sleeping_until_.store(next ? next->time_since_epoch().count() : idle, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (wheel_.next_expiration() != next) continue;
+
+            if (next) {
+                const auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(*next - WHEEL::clock::now());
+                if (d <= std::chrono::nanoseconds::zero()) continue;
+                waiter_.arm(d);
+            }
+            else {
+                waiter_.arm(std::chrono::nanoseconds::zero());
+            }
+
+            waiter_.wait();
+        }
+    }
+
+    WHEEL&                wheel_;
+    detail_::timer_waiter waiter_;
+    std::atomic<rep>      sleeping_until_{awake};
+    std::jthread          thread_;
+};
+} // namespace br
+
+#endif // __linux__
+
+#endif // BR_TIMER_WHEEL_DRIVER_H_
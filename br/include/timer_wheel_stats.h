@@ -0,0 +1,127 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BR_TIMER_WHEEL_STATS_H_
+#define BR_TIMER_WHEEL_STATS_H_
+
+#include "arch_info.h"
+#include "histogram.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace br {
+
+// Statistics policies of basic_timer_wheel. The wheel calls the on_*() hooks from
+// publish() and check_expiration(), and only reads the clock to time the expire()
+// callbacks when the policy is enabled.
+
+// Default policy: every hook is empty and takes no space in the wheel
+struct no_timer_wheel_stats {
+    static constexpr bool enabled = false;
+
+    void on_publish() noexcept {}
+    void on_slot(std::size_t, std::size_t) noexcept {}
+    void on_due(std::uint64_t) noexcept {}
+    void on_expire(std::uint64_t) noexcept {}
+};
+
+// Lock-free counters and histograms that can be snapshotted from any thread:
+//  - lateness: nanoseconds between the end of the slot of an entry and the
+//    check_expiration() that found it due, that is, how late it fired on top of
+//    the resolution of the wheel.
+//  - slot occupancy: entries held by every visited slot. Those not due yet are
+//    counted as skipped, they are the cost of deadlines further than a revolution.
+//  - callback time: nanoseconds spent in every expire() run by the wheel itself.
+//    Entries taken by the executor of check_expiration() are not timed.
+class timer_wheel_stats {
+public:
+    static constexpr bool enabled = true;
+
+    using histogram = log_histogram<>;
+
+    struct snapshot_type {
+        std::uint64_t published;
+        std::uint64_t expired;
+        std::uint64_t slots_visited;
+        std::uint64_t entries_skipped;
+
+        histogram::snapshot_type lateness;
+        histogram::snapshot_type slot_occupancy;
+        histogram::snapshot_type callback_time;
+    };
+
+    void on_publish() noexcept { published_.fetch_add(1, std::memory_order_relaxed); }
+
+    void on_slot(std::size_t entries, std::size_t due) noexcept
+    {
+        slots_visited_.fetch_add(1, std::memory_order_relaxed);
+        entries_skipped_.fetch_add(entries - due, std::memory_order_relaxed);
+        slot_occupancy_.record(entries);
+    }
+
+    void on_due(std::uint64_t lateness_ns) noexcept
+    {
+        expired_.fetch_add(1, std::memory_order_relaxed);
+        lateness_.record(lateness_ns);
+    }
+
+    void on_expire(std::uint64_t callback_ns) noexcept { callback_time_.record(callback_ns); }
+
+    [[nodiscard]] snapshot_type snapshot() const noexcept
+    {
+        return {published_.load(std::memory_order_relaxed),
+                expired_.load(std::memory_order_relaxed),
+                slots_visited_.load(std::memory_order_relaxed),
+                entries_skipped_.load(std::memory_order_relaxed),
+                lateness_.snapshot(),
+                slot_occupancy_.snapshot(),
+                callback_time_.snapshot()};
+    }
+
+    void reset() noexcept
+    {
+        published_.store(0, std::memory_order_relaxed);
+        expired_.store(0, std::memory_order_relaxed);
+        slots_visited_.store(0, std::memory_order_relaxed);
+        entries_skipped_.store(0, std::memory_order_relaxed);
+        lateness_.reset();
+        slot_occupancy_.reset();
+        callback_time_.reset();
+    }
+
+private:
+    // Bumped by the publishers, away from what the wheel thread writes
+    alignas(cache_line_size) std::atomic<std::uint64_t> published_{0};
+
+    alignas(cache_line_size) std::atomic<std::uint64_t> expired_{0};
+    std::atomic<std::uint64_t> slots_visited_{0};
+    std::atomic<std::uint64_t> entries_skipped_{0};
+
+    histogram lateness_;
+    histogram slot_occupancy_;
+    histogram callback_time_;
+};
+} // namespace br
+
+#endif // BR_TIMER_WHEEL_STATS_H_
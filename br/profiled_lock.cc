@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiled_lock.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace br {
+namespace detail_ {
+namespace {
+// Never destroyed, locks with static storage may outlive any other static
+ilist<lock_profile, std::mutex>& registry() noexcept
+{
+    static auto* r = new ilist<lock_profile, std::mutex>;
+    return *r;
+}
+} // namespace
+
+lock_profile::lock_profile()
+{
+    registry().push_back(this);
+}
+
+lock_profile::~lock_profile()
+{
+    // Before the counters go, dumps may be reading them
+    unlink();
+}
+
+lock_profile_stats lock_profile::stats() const noexcept
+{
+    lock_profile_stats s;
+    s.lock = this;
+    s.name = name_.load(std::memory_order_relaxed);
+    for (const auto& st : stripes_) {
+        s.acquisitions += st.acquisitions.load(std::memory_order_relaxed);
+        s.contended += st.contended.load(std::memory_order_relaxed);
+        s.wait_ns += st.wait_ns.load(std::memory_order_relaxed);
+        s.hold_ns += st.hold_ns.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void lock_profile::reset() noexcept
+{
+    for (auto& st : stripes_) {
+        st.acquisitions.store(0, std::memory_order_relaxed);
+        st.contended.store(0, std::memory_order_relaxed);
+        st.wait_ns.store(0, std::memory_order_relaxed);
+        st.hold_ns.store(0, std::memory_order_relaxed);
+    }
+}
+} // namespace detail_
+
+std::vector<lock_profile_stats> lock_profiles()
+{
+    std::vector<lock_profile_stats> v;
+    detail_::registry().for_each([&v](const detail_::lock_profile& p) { v.push_back(p.stats()); });
+    return v;
+}
+
+void dump_lock_profiles(std::ostream& os)
+{
+    auto v = lock_profiles();
+    std::sort(v.begin(), v.end(), [](const auto& a, const auto& b) { return a.wait_ns > b.wait_ns; });
+
+    for (const auto& s : v) {
+        os << (s.name ? s.name : "lock") << '@' << s.lock << " acquisitions=" << s.acquisitions
+           << " contended=" << s.contended << " wait_ns=" << s.wait_ns
+           << " hold_ns=" << s.hold_ns << '\n';
+    }
+}
+} // namespace br
@@ -1 +1,63 @@
-#include "spinlock.h"
\ No newline at end of file
+#include "spinlock.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace br {
+namespace detail_ {
+#if defined(__linux__)
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept
+{
+    syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void futex_wake_one(std::atomic<std::uint32_t>& word) noexcept
+{
+    syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+#else
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept
+{
+    word.wait(expected, std::memory_order_relaxed);
+}
+
+void futex_wake_one(std::atomic<std::uint32_t>& word) noexcept
+{
+    word.notify_one();
+}
+#endif
+} // namespace detail_
+
+void adaptive_mutex::lock_slow() noexcept
+{
+    // Read-only spin with backoff, in case the owner is about to leave
+    detail_::backoff<max_spins> b;
+    while (!b.saturated()) {
+        std::uint32_t expected = unlocked;
+        if (state_.load(std::memory_order_relaxed) == unlocked &&
+            state_.compare_exchange_weak(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+        }
+        b.pause();
+    }
+
+    // The owner may be descheduled, give it our CPU
+    for (unsigned i = 0; i < max_yields; ++i) {
+        std::uint32_t expected = unlocked;
+        if (state_.load(std::memory_order_relaxed) == unlocked &&
+            state_.compare_exchange_weak(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    // Park. Once contended, the lock is taken as contended too: we cannot tell whether
+    // other threads are still parked, so the next unlock must wake one
+    while (state_.exchange(contended, std::memory_order_acquire) != unlocked) {
+        detail_::futex_wait(state_, contended);
+    }
+}
+} // namespace br
@@ -0,0 +1,84 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "thread_index.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace br {
+namespace detail_ {
+namespace {
+// Never destroyed, so exiting threads can always give their index back
+class thread_index_pool {
+public:
+    static thread_index_pool& instance() noexcept
+    {
+        static auto* pool = new thread_index_pool;
+        return *pool;
+    }
+
+    unsigned acquire()
+    {
+        std::lock_guard l(lock_);
+        if (!free_.empty()) {
+            const auto i = free_.back();
+            free_.pop_back();
+            return i;
+        }
+        return bound_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release(unsigned i)
+    {
+        std::lock_guard l(lock_);
+        free_.push_back(i);
+    }
+
+    unsigned bound() const noexcept { return bound_.load(std::memory_order_acquire); }
+
+private:
+    std::mutex            lock_;
+    std::vector<unsigned> free_;
+    std::atomic<unsigned> bound_{0};
+};
+
+struct thread_index_holder {
+    const unsigned index = thread_index_pool::instance().acquire();
+
+    ~thread_index_holder() { thread_index_pool::instance().release(index); }
+};
+} // namespace
+
+unsigned thread_index() noexcept
+{
+    thread_local const thread_index_holder holder;
+    return holder.index;
+}
+
+unsigned thread_index_bound() noexcept
+{
+    return thread_index_pool::instance().bound();
+}
+} // namespace detail_
+} // namespace br
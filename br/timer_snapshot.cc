@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "timer_snapshot.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BR_HAS_MMAP 1
+#endif
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace br {
+namespace {
+#if defined(BR_HAS_MMAP)
+// Flushes the file, or directory, at path to the storage device
+void sync_path(const std::filesystem::path& path, int flags, const char* what)
+{
+    const int fd = open(path.c_str(), flags | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::system_category(), what);
+
+    if (fsync(fd) < 0) {
+        const auto err = errno;
+        close(fd);
+        throw std::system_error(err, std::system_category(), what);
+    }
+    close(fd);
+}
+#endif
+} // namespace
+
+timer_snapshot::timer_snapshot(const std::filesystem::path& path)
+{
+#if defined(BR_HAS_MMAP)
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::system_category(), "Cannot open the timer snapshot");
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0) {
+        const auto err = errno;
+        close(fd);
+        throw std::system_error(err, std::system_category(), "Cannot stat the timer snapshot");
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ >= sizeof(timer_snapshot_header)) {
+        void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            const auto err = errno;
+            close(fd);
+            throw std::system_error(err, std::system_category(), "Cannot map the timer snapshot");
+        }
+        data_ = static_cast<const std::byte*>(p);
+    }
+    close(fd);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), "Cannot open the timer snapshot");
+
+    buffer_.resize(static_cast<std::size_t>(std::filesystem::file_size(path)));
+    in.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    if (!in) throw std::system_error(std::make_error_code(std::errc::io_error), "Cannot read the timer snapshot");
+
+    size_ = buffer_.size();
+    data_ = buffer_.data();
+#endif
+
+    const bool valid = size_ >= sizeof(timer_snapshot_header)
+                       && header().magic == timer_snapshot_header::magic_value
+                       && header().version == timer_snapshot_header::version_value
+                       && header().count == (size_ - sizeof(timer_snapshot_header)) / sizeof(timer_snapshot_record)
+                       && (size_ - sizeof(timer_snapshot_header)) % sizeof(timer_snapshot_record) == 0;
+    if (!valid) {
+        unmap();
+        throw std::runtime_error("Not a timer snapshot of a supported version");
+    }
+}
+
+timer_snapshot::~timer_snapshot()
+{
+    unmap();
+}
+
+void timer_snapshot::unmap() noexcept
+{
+#if defined(BR_HAS_MMAP)
+    if (data_) munmap(const_cast<std::byte*>(data_), size_);
+#endif
+    data_ = nullptr;
+}
+
+void write_timer_snapshot(const std::filesystem::path&           path,
+                          std::chrono::nanoseconds               saved_at,
+                          std::span<const timer_snapshot_record> records)
+{
+    const timer_snapshot_header header{timer_snapshot_header::magic_value,
+                                       timer_snapshot_header::version_value,
+                                       records.size(),
+                                       saved_at.count(),
+                                       0};
+
+    auto tmp = path;
+    tmp += ".tmp";
+    try {
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+            out.flush();
+            if (!out) throw std::system_error(std::make_error_code(std::errc::io_error), "Cannot write the timer snapshot");
+        }
+
+#if defined(BR_HAS_MMAP)
+        // The data must be on disk before the rename is, or a power loss could leave the
+        // new name pointing to a file without them
+        sync_path(tmp, O_RDONLY, "Cannot sync the timer snapshot");
+#endif
+
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) throw std::system_error(ec, "Cannot replace the timer snapshot");
+    }
+    catch (...) {
+        // Do not leave a partial snapshot behind, the previous one is still in place
+        std::error_code ec;
+        std::filesystem::remove(tmp, ec);
+        throw;
+    }
+
+#if defined(BR_HAS_MMAP)
+    // And the rename itself, which lives in the directory
+    const auto dir = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+    sync_path(dir, O_RDONLY | O_DIRECTORY, "Cannot sync the timer snapshot directory");
+#endif
+}
+
+} // namespace br
@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright (c) 2025 Sergio Pérez Camacho
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "timer_wheel_driver.h"
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace br::detail_ {
+
+timer_waiter::timer_waiter()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC))
+    , timer_fd_(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+    , event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (epoll_fd_ < 0 || timer_fd_ < 0 || event_fd_ < 0) {
+        const auto err = errno;
+        close_all();
+        throw std::system_error(err, std::system_category(), "Cannot create the timer wheel driver descriptors");
+    }
+
+    for (const int fd : {timer_fd_, event_fd_}) {
+        epoll_event ev{};
+        ev.events  = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+}
+
+timer_waiter::~timer_waiter()
+{
+    close_all();
+}
+
+void timer_waiter::close_all() noexcept
+{
+    for (const int fd : {epoll_fd_, timer_fd_, event_fd_}) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void timer_waiter::arm(std::chrono::nanoseconds d) noexcept
+{
+    const auto s = std::chrono::duration_cast<std::chrono::seconds>(d);
+    itimerspec its{};
+    its.it_value.tv_sec  = s.count();
+    its.it_value.tv_nsec = (d - s).count();
+    timerfd_settime(timer_fd_, 0, &its, nullptr);
+}
+
+void timer_waiter::wait() noexcept
+{
+    epoll_event events[2];
+    const int   n = epoll_wait(epoll_fd_, events, 2, -1);
+
+    for (int i = 0; i < n; ++i) {
+        std::uint64_t count;
+        [[maybe_unused]] const auto r = read(events[i].data.fd, &count, sizeof(count));
+    }
+}
+
+void timer_waiter::wake() noexcept
+{
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const auto r = write(event_fd_, &one, sizeof(one));
+}
+
+} // namespace br::detail_
+
+#endif // __linux__
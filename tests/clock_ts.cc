@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "clock.h"
+
+class ClockTest: public testing::Test {
+protected:
+    ClockTest()           = default;
+    ~ClockTest() override = default;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    template <typename CLOCK>
+    static void check_against_steady_clock()
+    {
+        const auto c0 = CLOCK::now();
+        const auto s0 = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto c1 = CLOCK::now();
+        const auto s1 = std::chrono::steady_clock::now();
+
+        EXPECT_LE(c0, c1);
+        const auto drift = std::chrono::abs((c1 - c0) - (s1 - s0));
+        EXPECT_LT(drift, std::chrono::milliseconds(10));
+    }
+};
+
+
+TEST_F(ClockTest, Coarse)
+{
+    check_against_steady_clock<br::coarse_steady_clock>();
+}
+
+TEST_F(ClockTest, Tsc)
+{
+    EXPECT_GT(br::tsc_clock::frequency(), 0);
+
+    check_against_steady_clock<br::tsc_clock>();
+}
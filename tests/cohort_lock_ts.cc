@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+#include "cohort_lock.h"
+#include "ilist.h"
+
+TEST(CohortLockTest, Topology)
+{
+    const auto n = br::detail_::numa_node_count();
+    EXPECT_GE(n, 1);
+    EXPECT_LT(br::detail_::numa_node_of_cpu(br::arch_info::current_cpu()), n);
+    EXPECT_EQ(br::detail_::numa_node_of_cpu(1u << 30), 0);
+}
+
+TEST(CohortLockTest, TryLock)
+{
+    br::cohort_lock<> l;
+    EXPECT_TRUE(l.try_lock());
+    EXPECT_FALSE(l.try_lock());
+    l.unlock();
+    EXPECT_TRUE(l.try_lock());
+    l.unlock();
+}
+
+TEST(CohortLockTest, MutualExclusion)
+{
+    // A single local hand-off in a row, so the global lock changes hands too
+    for (const unsigned handoffs : {1u, 64u}) {
+        br::cohort_lock<> l(handoffs);
+        long              counter = 0;
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&]() {
+                    for (int i = 0; i < 5000; ++i) {
+                        std::lock_guard g(l);
+                        counter = counter + 1;
+                    }
+                });
+            }
+        }
+        EXPECT_EQ(counter, 20000);
+    }
+}
+
+TEST(CohortLockTest, AsIlistLock)
+{
+    struct E final: br::ilist<E, br::cohort_lock<>>::node {};
+
+    br::ilist<E, br::cohort_lock<>> list;
+    std::vector<E>                  v(1000);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = t; i < 1000; i += 4) list.push_back(&v[i]);
+            });
+        }
+    }
+    EXPECT_EQ(list.size(), 1000);
+    while (list.pop_front()) {}
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "concurrent_ilist.h"
+
+namespace {
+
+struct E final: br::concurrent_ilist<E>::node {
+    static inline std::atomic<int> alive{0};
+
+    explicit E(int v) : value(v) { ++alive; }
+    ~E() { value = -1; --alive; }
+
+    int value;
+};
+
+} // namespace
+
+TEST(ConcurrentIlistTest, Basic)
+{
+    br::epoch_domain         d;
+    br::concurrent_ilist<E> l(d);
+
+    E a(1), b(2), c(3);
+    l.push_back(&b);
+    l.push_back(&c);
+    l.push_front(&a);
+    EXPECT_EQ(l.size(), 3);
+    EXPECT_TRUE(b.linked());
+
+    std::vector<int> seen;
+    l.for_each([&](E& e) { seen.push_back(e.value); });
+    EXPECT_EQ(seen, (std::vector<int>{1, 2, 3}));
+
+    EXPECT_TRUE(l.erase(&c));
+    EXPECT_FALSE(l.erase(&c));
+    EXPECT_TRUE(l.erase(&a));
+    EXPECT_FALSE(c.linked());
+
+    // Tail moved back to b
+    l.push_back(&a);
+    seen.clear();
+    l.for_each([&](E& e) { seen.push_back(e.value); });
+    EXPECT_EQ(seen, (std::vector<int>{2, 1}));
+
+    EXPECT_EQ(l.find_if([](const E& e) { return e.value == 1; }), &a);
+    EXPECT_EQ(l.find_if([](const E& e) { return e.value == 3; }), nullptr);
+
+    // Already linked: left where it is
+    EXPECT_FALSE(l.push_front(&a));
+    EXPECT_FALSE(l.push_back(&b));
+    EXPECT_EQ(l.size(), 2);
+    seen.clear();
+    l.for_each([&](E& e) { seen.push_back(e.value); });
+    EXPECT_EQ(seen, (std::vector<int>{2, 1}));
+
+    l.erase(&a);
+    l.erase(&b);
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(ConcurrentIlistTest, ReadersWhileWritersEraseAndRetire)
+{
+    br::epoch_domain         d;
+    br::concurrent_ilist<E> l(d);
+
+    constexpr int n = 64;
+    std::vector<E*> live;
+    for (int i = 0; i < n; ++i) {
+        live.push_back(new E(i));
+        l.push_back(live.back());
+    }
+
+    std::atomic<bool>        stop{false};
+    std::atomic<long>        bad{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!stop) {
+                l.for_each([&](E& e) {
+                    if (e.value < 0) ++bad;
+                });
+            }
+        });
+    }
+
+    // Replace every node many times, retiring the old ones
+    for (int round = 0; round < 200; ++round) {
+        for (auto& e : live) {
+            auto* fresh = new E(e->value);
+            l.push_back(fresh);
+            l.erase_and_retire(e);
+            e = fresh;
+        }
+    }
+
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(bad, 0);
+    EXPECT_EQ(l.size(), n);
+
+    for (auto* e : live) l.erase_and_retire(e);
+    d.synchronize();
+    EXPECT_EQ(E::alive, 0);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "epoch.h"
+
+namespace {
+
+struct counted {
+    static inline std::atomic<int> alive{0};
+
+    counted() { ++alive; }
+    ~counted() { --alive; }
+};
+
+} // namespace
+
+TEST(EpochTest, ThreadIndex)
+{
+    const auto i = br::detail_::thread_index();
+    EXPECT_EQ(i, br::detail_::thread_index());
+    EXPECT_LT(i, br::detail_::thread_index_bound());
+
+    unsigned other = i;
+    std::thread([&] { other = br::detail_::thread_index(); }).join();
+    EXPECT_NE(other, i);
+}
+
+TEST(EpochTest, RetireAndCollect)
+{
+    br::epoch_domain d;
+    d.retire(new counted);
+    d.retire(new counted);
+    EXPECT_EQ(counted::alive, 2);
+
+    // Needs two epoch advances
+    EXPECT_EQ(d.collect(), 0);
+    EXPECT_EQ(d.collect(), 2);
+    EXPECT_EQ(counted::alive, 0);
+}
+
+TEST(EpochTest, PinnedReaderBlocksReclamation)
+{
+    br::epoch_domain d;
+
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread       reader([&] {
+        const auto g = d.pin();
+        {
+            // Nested guards keep the outer one in force
+            const auto inner = d.pin();
+        }
+        pinned = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!pinned) std::this_thread::yield();
+
+    d.retire(new counted);
+    for (int i = 0; i < 10; ++i) d.collect();
+    EXPECT_EQ(counted::alive, 1);
+
+    release = true;
+    reader.join();
+    d.synchronize();
+    EXPECT_EQ(counted::alive, 0);
+}
+
+TEST(EpochTest, MoreThreadsThanSlots)
+{
+    // A single slot: the readers have higher thread indices and share the overflow count
+    br::epoch_domain d(1);
+
+    std::atomic<bool>        release{false};
+    std::atomic<int>         pinned{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            const auto g = d.pin();
+            {
+                const auto inner = d.pin();
+            }
+            ++pinned;
+            while (!release) std::this_thread::yield();
+        });
+    }
+    while (pinned != 4) std::this_thread::yield();
+
+    d.retire(new counted);
+    for (int i = 0; i < 10; ++i) d.collect();
+    EXPECT_EQ(counted::alive, 1);
+
+    release = true;
+    for (auto& t : readers) t.join();
+    d.synchronize();
+    EXPECT_EQ(counted::alive, 0);
+}
+
+TEST(EpochTest, DestructorFreesLimbo)
+{
+    {
+        br::epoch_domain d;
+        for (int i = 0; i < 10; ++i) d.retire(new counted);
+    }
+    EXPECT_EQ(counted::alive, 0);
+}
+
+TEST(EpochTest, ConcurrentRetire)
+{
+    br::epoch_domain         d;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) {
+                const auto g = d.pin();
+                d.retire(new counted);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    d.synchronize();
+    EXPECT_EQ(counted::alive, 0);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+#include "fair_lock.h"
+#include "ilist.h"
+
+template <typename LOCK>
+class FairLockTest: public testing::Test {
+protected:
+    LOCK l;
+};
+
+using FairLocks = testing::Types<br::ticket_lock, br::mcs_lock>;
+TYPED_TEST_SUITE(FairLockTest, FairLocks);
+
+TYPED_TEST(FairLockTest, TryLock)
+{
+    EXPECT_TRUE(this->l.try_lock());
+    EXPECT_FALSE(this->l.try_lock());
+
+    bool other = true;
+    std::jthread([&]() { other = this->l.try_lock(); }).join();
+    EXPECT_FALSE(other);
+
+    this->l.unlock();
+    EXPECT_TRUE(this->l.try_lock());
+    this->l.unlock();
+}
+
+TYPED_TEST(FairLockTest, MutualExclusion)
+{
+    long counter = 0;
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 20000; ++i) {
+                    std::lock_guard g(this->l);
+                    counter = counter + 1;
+                }
+            });
+        }
+    }
+    EXPECT_EQ(counter, 80000);
+}
+
+TYPED_TEST(FairLockTest, Fifo)
+{
+    std::vector<int> order;
+
+    this->l.lock();
+    {
+        // Queue the waiters one by one, giving each time to get in line
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                std::lock_guard g(this->l);
+                order.push_back(t);
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        this->l.unlock();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TYPED_TEST(FairLockTest, AsIlistLock)
+{
+    struct E final: br::ilist<E, TypeParam>::node {};
+
+    br::ilist<E, TypeParam> list;
+    std::vector<E>          v(1000);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = t; i < 1000; i += 4) list.push_back(&v[i]);
+            });
+        }
+    }
+    EXPECT_EQ(list.size(), 1000);
+    while (list.pop_front()) {}
+}
+
+TEST(McsLockTest, SeveralLocksHeld)
+{
+    br::mcs_lock a;
+    br::mcs_lock b;
+
+    // Each held lock uses its own queue node, released in any order
+    a.lock();
+    b.lock();
+    a.unlock();
+    EXPECT_TRUE(a.try_lock());
+    b.unlock();
+    a.unlock();
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "hierarchical_timer_wheel.h"
+
+class HierarchicalTimerWheelTest: public testing::Test {
+protected:
+    HierarchicalTimerWheelTest()           = default;
+    ~HierarchicalTimerWheelTest() override = default;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    struct K final: br::ts_expirable {
+        int a{0};
+
+        void expire() override
+        {
+            a = 1337;
+        }
+    };
+
+    struct L final: br::expirable {
+        std::chrono::seconds deadline{0};
+        std::chrono::seconds fired{-1};
+        br::time_point*      now{nullptr};
+
+        void expire() override
+        {
+            fired = std::chrono::duration_cast<std::chrono::seconds>(now->time_since_epoch());
+        }
+    };
+};
+
+
+TEST_F(HierarchicalTimerWheelTest, Basic)
+{
+    const std::chrono::time_point<std::chrono::steady_clock> t;
+
+    br::ts_hierarchical_timer_wheel tw(std::chrono::seconds(1), 8, 3, t);
+
+    K k;
+    K l;
+
+    tw.publish(&k, t+std::chrono::seconds(200));
+    tw.publish(&l, t+std::chrono::seconds(100));
+
+    tw.check_expiration(t+std::chrono::seconds(99));
+
+    EXPECT_EQ(k.a, 0);
+    EXPECT_EQ(l.a, 0);
+
+    tw.check_expiration(t+std::chrono::seconds(101));
+
+    EXPECT_EQ(k.a, 0);
+    EXPECT_EQ(l.a, 1337);
+
+    tw.check_expiration(t+std::chrono::seconds(200));
+
+    EXPECT_EQ(k.a, 0);
+    EXPECT_EQ(l.a, 1337);
+
+    tw.check_expiration(t+std::chrono::seconds(201));
+
+    EXPECT_EQ(k.a, 1337);
+    EXPECT_EQ(l.a, 1337);
+}
+
+TEST_F(HierarchicalTimerWheelTest, BeyondRange)
+{
+    br::time_point now;
+
+    // 4 slots x 2 levels only cover 16 ticks
+    br::hierarchical_timer_wheel tw(std::chrono::seconds(1), 4, 2, now);
+
+    std::vector<L> v(200);
+    std::mt19937   gen(1337);
+    for (auto& l : v) {
+        l.deadline = std::chrono::seconds(std::uniform_int_distribution<int>(0, 150)(gen));
+        l.now      = &now;
+        tw.publish(&l, now + l.deadline);
+    }
+
+    for (int s = 1; s <= 160; ++s) {
+        now = br::time_point{} + std::chrono::seconds(s);
+        tw.check_expiration(now);
+    }
+
+    for (const auto& l : v) {
+        EXPECT_EQ(l.fired, l.deadline + std::chrono::seconds(1));
+    }
+}
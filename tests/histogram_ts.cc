@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "histogram.h"
+
+#include <random>
+
+TEST(LogHistogramTest, Buckets)
+{
+    using h = br::log_histogram<4>;
+
+    // Contiguous, non overlapping buckets covering all the 64 bits values
+    EXPECT_EQ(h::lowest_of(0), 0);
+    for (std::size_t i = 1; i < h::n_buckets; ++i) {
+        EXPECT_EQ(h::lowest_of(i), h::highest_of(i - 1) + 1);
+        EXPECT_EQ(h::bucket_of(h::lowest_of(i)), i);
+        EXPECT_EQ(h::bucket_of(h::highest_of(i)), i);
+    }
+    EXPECT_EQ(h::highest_of(h::n_buckets - 1), std::numeric_limits<std::uint64_t>::max());
+
+    // Relative error below 1/16
+    for (std::size_t i = 16; i < h::n_buckets; ++i) {
+        EXPECT_LT(h::highest_of(i) - h::lowest_of(i), h::lowest_of(i) / 16 + 1);
+    }
+}
+
+TEST(LogHistogramTest, Percentile)
+{
+    br::log_histogram<> h;
+    EXPECT_EQ(h.snapshot().percentile(0.99), 0);
+
+    for (std::uint64_t v = 1; v <= 1000; ++v) h.record(v);
+
+    const auto s = h.snapshot();
+    EXPECT_EQ(s.count(), 1000);
+    EXPECT_EQ(s.sum(), 500500);
+    EXPECT_NEAR(s.percentile(0.5), 500, 500 / 16);
+    EXPECT_NEAR(s.percentile(0.99), 990, 990 / 16);
+    EXPECT_GE(s.max(), 1000);
+    EXPECT_LT(s.max(), 1000 + 1000 / 16);
+}
@@ -130,3 +130,108 @@ TEST_F(IListTest, Clear)
         delete k;
     }
 }
+
+TEST_F(IListTest, PushBackBatch)
+{
+    LW              l;
+    std::vector<K>  v(5);
+    std::vector<K*> p;
+    for (auto& k : v) p.push_back(&k);
+
+    l.push_back(p[2]);
+    EXPECT_EQ(l.push_back_batch(p.begin(), p.end()), 4);
+    EXPECT_EQ(l.size(), 5);
+
+    // In order, with the already linked one left where it was
+    std::vector<K*> order;
+    l.for_each([&](K& k) { order.push_back(&k); });
+    EXPECT_EQ(order, (std::vector<K*>{p[2], p[0], p[1], p[3], p[4]}));
+
+    l.clear();
+}
+
+TEST_F(IListTest, Tags)
+{
+    struct lru_tag;
+    struct shard_tag;
+
+    struct S;
+    using timers = br::ilist<S>;
+    using lru    = br::ilist<S, std::mutex, lru_tag>;
+    using shard  = br::ilist<S, br::detail_::void_mutex, shard_tag, br::link_mode::normal>;
+
+    struct S final: timers::node, lru::node, shard::node {
+        int a{0};
+    };
+
+    // One hook per list, three pointers each and no vtable
+    static_assert(!std::is_polymorphic_v<S>);
+    static_assert(sizeof(S) <= 9 * sizeof(void*) + sizeof(int) + alignof(S));
+
+    timers t;
+    lru    l;
+    shard  s;
+
+    {
+        S k;
+        t.push_back(&k);
+        l.push_back(&k);
+        s.push_back(&k);
+        EXPECT_EQ(t.front(), &k);
+        EXPECT_EQ(l.front(), &k);
+        EXPECT_EQ(s.front(), &k);
+
+        static_cast<lru::node&>(k).unlink();
+        EXPECT_TRUE(l.empty());
+        EXPECT_EQ(t.size(), 1);
+
+        // normal hooks are not unlinked by the destructor
+        EXPECT_EQ(s.pop_front(), &k);
+    }
+
+    // auto_unlink hooks are
+    EXPECT_TRUE(t.empty());
+}
+
+TEST_F(IListTest, Splice)
+{
+    LW              a;
+    LW              b;
+    std::vector<K>  v(6);
+    std::vector<K*> p;
+    for (auto& k : v) p.push_back(&k);
+
+    a.push_back_batch(p.begin(), p.begin() + 3);
+    b.push_back_batch(p.begin() + 3, p.end());
+
+    EXPECT_EQ(a.splice(b), 3);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 6);
+
+    // Nodes moved belong to the new list
+    p[4]->unlink();
+    EXPECT_EQ(a.size(), 5);
+
+    // [second, fifth) of a
+    auto first = a.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    ++last;
+    EXPECT_EQ(b.splice(a, first, last), 3);
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_EQ(b.size(), 3);
+
+    std::vector<K*> order;
+    b.for_each([&](K& k) { order.push_back(&k); });
+    EXPECT_EQ(order, (std::vector<K*>{p[1], p[2], p[3]}));
+
+    EXPECT_EQ(b.drain_to(a), 3);
+    order.clear();
+    a.for_each([&](K& k) { order.push_back(&k); });
+    EXPECT_EQ(order, (std::vector<K*>{p[0], p[5], p[1], p[2], p[3]}));
+    EXPECT_EQ(a.splice(a), 0);
+
+    a.clear();
+}
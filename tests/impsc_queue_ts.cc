@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "impsc_queue.h"
+
+class IMpscQueueTest: public testing::Test {
+protected:
+    struct K;
+    using Q = br::impsc_queue<K>;
+
+    struct K final: Q::node {
+        int producer{0};
+        int seq{0};
+    };
+};
+
+TEST_F(IMpscQueueTest, Basic)
+{
+    Q q;
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop(), nullptr);
+
+    K a;
+    K b;
+    q.push(&a);
+    q.push(&b);
+    EXPECT_FALSE(q.empty());
+
+    EXPECT_EQ(q.pop(), &a);
+    EXPECT_EQ(q.pop(), &b);
+    EXPECT_EQ(q.pop(), nullptr);
+    EXPECT_TRUE(q.empty());
+
+    // Nodes can be pushed again once popped
+    q.push(&b);
+    EXPECT_EQ(q.pop(), &b);
+}
+
+TEST_F(IMpscQueueTest, Producers)
+{
+    constexpr int n_producers = 4;
+    constexpr int n_items     = 100000;
+
+    Q                           q;
+    std::vector<std::vector<K>> items(n_producers);
+    {
+        std::vector<std::jthread> producers;
+        for (int p = 0; p < n_producers; ++p) {
+            items[p] = std::vector<K>(n_items);
+            producers.emplace_back([&q, &v = items[p], p]() {
+                for (int i = 0; i < n_items; ++i) {
+                    v[i].producer = p;
+                    v[i].seq      = i;
+                    q.push(&v[i]);
+                }
+            });
+        }
+
+        // FIFO per producer
+        std::vector<int> next(n_producers, 0);
+        for (int received = 0; received < n_producers * n_items;) {
+            if (auto* k = q.pop()) {
+                ASSERT_EQ(k->seq, next[k->producer]++);
+                ++received;
+            }
+        }
+    }
+
+    EXPECT_EQ(q.pop(), nullptr);
+}
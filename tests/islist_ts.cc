@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ilist.h"
+#include "islist.h"
+
+class ISListTest: public testing::Test {
+protected:
+    struct K;
+    using LW = br::islist<K, std::mutex>;
+
+    struct K final: LW::node {
+        int a{1};
+    };
+};
+
+TEST_F(ISListTest, Footprint)
+{
+    struct S final: br::islist<S>::node {};
+    struct D final: br::ilist<D>::node {};
+
+    static_assert(sizeof(S) == sizeof(void*));
+    static_assert(sizeof(D) == 3 * sizeof(void*));
+}
+
+TEST_F(ISListTest, Basic)
+{
+    LW             l;
+    std::vector<K> v(3);
+    EXPECT_EQ(l.pop_front(), nullptr);
+
+    // Queue
+    l.push_back(&v[0]);
+    l.push_back(&v[1]);
+    l.push_back(&v[2]);
+    EXPECT_EQ(l.size(), 3);
+    EXPECT_EQ(l.front(), &v[0]);
+    EXPECT_EQ(l.back(), &v[2]);
+    EXPECT_EQ(l.front()->next(), &v[1]);
+    EXPECT_EQ(l.pop_front(), &v[0]);
+    EXPECT_EQ(l.pop_front(), &v[1]);
+    EXPECT_EQ(l.pop_front(), &v[2]);
+    EXPECT_TRUE(l.empty());
+
+    // Stack
+    l.push_front(&v[0]);
+    l.push_front(&v[1]);
+    EXPECT_EQ(l.pop_front(), &v[1]);
+    EXPECT_EQ(l.pop_front(), &v[0]);
+    EXPECT_EQ(l.back(), nullptr);
+}
+
+TEST_F(ISListTest, Splice)
+{
+    LW             a;
+    LW             b;
+    std::vector<K> v(5);
+
+    a.push_back(&v[0]);
+    a.push_back(&v[1]);
+    b.push_back(&v[2]);
+    b.push_back(&v[3]);
+
+    EXPECT_EQ(a.splice(b), 2);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.back(), &v[3]);
+
+    a.push_back(&v[4]);
+    EXPECT_EQ(a.drain_to(b), 5);
+    EXPECT_EQ(b.splice(a), 0);
+
+    std::vector<K*> order;
+    b.for_each([&](K& k) { order.push_back(&k); });
+    EXPECT_EQ(order, (std::vector<K*>{&v[0], &v[1], &v[2], &v[3], &v[4]}));
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "istack.h"
+
+class IStackTest: public testing::Test {
+protected:
+    struct K;
+    using S = br::istack<K>;
+
+    struct K final: S::node {
+        int a{0};
+    };
+};
+
+TEST_F(IStackTest, Basic)
+{
+    S s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.pop(), nullptr);
+
+    K a;
+    K b;
+    K c;
+    s.push(&a);
+    s.push(&b);
+    EXPECT_EQ(s.pop(), &b);
+
+    s.push(&c);
+    auto* all = s.pop_all();
+    EXPECT_EQ(all, &c);
+    EXPECT_EQ(all->next(), &a);
+    EXPECT_EQ(all->next()->next(), nullptr);
+    EXPECT_TRUE(s.empty());
+}
+
+TEST_F(IStackTest, Producers)
+{
+    constexpr int n_producers = 4;
+    constexpr int n_items     = 100000;
+
+    S              s;
+    std::vector<K> items(n_producers * n_items);
+    {
+        std::vector<std::jthread> producers;
+        for (int p = 0; p < n_producers; ++p) {
+            producers.emplace_back([&s, &items, p]() {
+                for (int i = p * n_items; i < (p + 1) * n_items; ++i) s.push(&items[i]);
+            });
+        }
+
+        for (int received = 0; received < n_producers * n_items;) {
+            if (auto* k = s.pop()) {
+                ++k->a;
+                ++received;
+            }
+            for (auto* k = s.pop_all(); k; k = k->next()) {
+                ++k->a;
+                ++received;
+            }
+        }
+    }
+
+    for (const auto& k : items) EXPECT_EQ(k.a, 1);
+}
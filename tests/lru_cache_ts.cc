@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <random>
+#include <thread>
+
+#include "lru_cache.h"
+
+class LruCacheTest: public testing::Test {
+protected:
+    struct E;
+    using lru = br::lru_cache<E, int>;
+
+    struct E final: lru::node {
+        int value{0};
+    };
+};
+
+TEST_F(LruCacheTest, Basic)
+{
+    lru            c(3);
+    std::vector<E> v(5);
+
+    EXPECT_EQ(c.insert(1, &v[1]), nullptr);
+    EXPECT_EQ(c.insert(2, &v[2]), nullptr);
+    EXPECT_EQ(c.insert(3, &v[3]), nullptr);
+    EXPECT_EQ(c.size(), 3);
+
+    // 1 becomes the most recent, 2 the least
+    EXPECT_EQ(c.find(1), &v[1]);
+    EXPECT_EQ(c.find(4), nullptr);
+
+    EXPECT_EQ(c.insert(4, &v[4]), &v[2]);
+    EXPECT_EQ(c.find(2), nullptr);
+    EXPECT_EQ(v[4].key(), 4);
+
+    // Replacing a key hands back the previous entry
+    EXPECT_EQ(c.insert(4, &v[0]), &v[4]);
+    EXPECT_EQ(c.find(4), &v[0]);
+
+    EXPECT_TRUE(c.erase(&v[3]));
+    EXPECT_FALSE(c.erase(&v[3]));
+    EXPECT_EQ(c.erase(1), &v[1]);
+    EXPECT_EQ(c.size(), 1);
+
+    const auto s = c.stats();
+    EXPECT_EQ(s.hits, 2);
+    EXPECT_EQ(s.misses, 2);
+    EXPECT_EQ(s.evictions, 1);
+}
+
+TEST_F(LruCacheTest, SecondChance)
+{
+    struct C;
+    using CC = br::clock_cache<C, int>;
+
+    struct C final: CC::node {};
+
+    CC             c(2);
+    std::vector<C> v(3);
+
+    c.insert(0, &v[0]);
+    c.insert(1, &v[1]);
+    EXPECT_EQ(c.find(0), &v[0]);
+
+    // 0 is the oldest but was referenced
+    EXPECT_EQ(c.insert(2, &v[2]), &v[1]);
+    EXPECT_EQ(c.find(0), &v[0]);
+    EXPECT_EQ(c.find(2), &v[2]);
+}
+
+TEST_F(LruCacheTest, Random)
+{
+    // Against a reference model, with enough churn to exercise the index deletions
+    constexpr int capacity = 100;
+
+    lru            c(capacity);
+    std::vector<E> v(1000);
+    std::list<int> model;
+
+    std::mt19937                    gen(1337);
+    std::uniform_int_distribution<> dist(0, 999);
+    for (int i = 0; i < 100000; ++i) {
+        const auto k  = dist(gen);
+        const auto it = std::find(model.begin(), model.end(), k);
+        auto*      e  = c.find(k);
+        ASSERT_EQ(e != nullptr, it != model.end());
+
+        if (e) {
+            ASSERT_EQ(e->value, k);
+            model.erase(it);
+            model.push_front(k);
+        }
+        else {
+            v[k].value = k;
+            auto* out  = c.insert(k, &v[k]);
+            if (model.size() == capacity) {
+                ASSERT_EQ(out, &v[model.back()]);
+                model.pop_back();
+            }
+            model.push_front(k);
+        }
+    }
+    EXPECT_EQ(c.size(), capacity);
+}
+
+TEST_F(LruCacheTest, Sharded)
+{
+    constexpr int n_threads = 4;
+    constexpr int n_keys    = 1000;
+
+    br::sharded_lru_cache<E, int> c(n_keys, 8);
+    std::vector<E>                v(n_threads * n_keys);
+    std::atomic<std::size_t>      hits{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&c, &v, &hits, t]() {
+                for (int k = t * n_keys; k < (t + 1) * n_keys; ++k) {
+                    v[k].value = k;
+                    c.insert(k, &v[k]);
+                    // Other threads may have evicted it already
+                    int found = -1;
+                    if (c.visit(k, [&](E& e) { found = e.value; })) {
+                        EXPECT_EQ(found, k);
+                        ++hits;
+                    }
+                }
+            });
+        }
+    }
+
+    EXPECT_LE(c.size(), n_keys + 8);
+    const auto s = c.stats();
+    EXPECT_EQ(s.hits, hits);
+    EXPECT_EQ(s.evictions, n_threads * n_keys - c.size());
+}
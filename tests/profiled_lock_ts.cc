@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "fair_lock.h"
+#include "ilist.h"
+#include "profiled_lock.h"
+#include "spinlock.h"
+
+namespace {
+const br::lock_profile_stats* find(const std::vector<br::lock_profile_stats>& v, const void* lock)
+{
+    const auto it = std::find_if(v.begin(), v.end(), [lock](const auto& s) { return s.lock == lock; });
+    return it == v.end() ? nullptr : &*it;
+}
+} // namespace
+
+#if defined(BR_LOCK_PROFILING)
+static_assert(std::is_same_v<br::profiled_lock<std::mutex>, br::basic_profiled_lock<std::mutex>>);
+#else
+static_assert(std::is_same_v<br::profiled_lock<std::mutex>, std::mutex>);
+#endif
+
+TEST(ProfiledLockTest, Uncontended)
+{
+    br::basic_profiled_lock<br::spinlock> l;
+    for (int i = 0; i < 10; ++i) {
+        std::lock_guard g(l);
+    }
+    EXPECT_TRUE(l.try_lock());
+    EXPECT_FALSE(l.try_lock());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    l.unlock();
+
+    const auto s = l.stats();
+    EXPECT_EQ(s.acquisitions, 11);
+    EXPECT_EQ(s.contended, 0);
+    EXPECT_EQ(s.wait_ns, 0);
+    EXPECT_GE(s.hold_ns, 1000000);
+
+    l.reset();
+    EXPECT_EQ(l.stats().acquisitions, 0);
+}
+
+TEST(ProfiledLockTest, Contended)
+{
+    br::basic_profiled_lock<std::mutex> l;
+
+    l.lock();
+    std::jthread t([&l]() { std::lock_guard g(l); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    l.unlock();
+    t.join();
+
+    const auto s = l.stats();
+    EXPECT_EQ(s.acquisitions, 2);
+    EXPECT_EQ(s.contended, 1);
+    EXPECT_GE(s.wait_ns, 10000000);
+    EXPECT_GE(s.hold_ns, 20000000);
+}
+
+TEST(ProfiledLockTest, KeepsFifoOrder)
+{
+    br::basic_profiled_lock<br::ticket_lock> l;
+    std::vector<int>                         order;
+
+    l.lock();
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                std::lock_guard g(l);
+                order.push_back(t);
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        l.unlock();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(l.stats().contended, 4);
+}
+
+TEST(ProfiledLockTest, Registry)
+{
+    const void* address = nullptr;
+    {
+        br::basic_profiled_lock<std::mutex> l;
+        br::set_lock_name(l, "sessions");
+        address = &l;
+        l.lock();
+        l.unlock();
+
+        const auto  v = br::lock_profiles();
+        const auto* s = find(v, address);
+        ASSERT_NE(s, nullptr);
+        EXPECT_STREQ(s->name, "sessions");
+        EXPECT_EQ(s->acquisitions, 1);
+
+        std::ostringstream os;
+        br::dump_lock_profiles(os);
+        EXPECT_NE(os.str().find("sessions@"), std::string::npos);
+    }
+    EXPECT_EQ(find(br::lock_profiles(), address), nullptr);
+
+    // Unprofiled locks are left alone
+    std::mutex m;
+    br::set_lock_name(m, "ignored");
+}
+
+TEST(ProfiledLockTest, AsIlistLock)
+{
+    struct E final: br::ilist<E, br::basic_profiled_lock<br::adaptive_mutex>>::node {};
+
+    br::ilist<E, br::basic_profiled_lock<br::adaptive_mutex>> list;
+    std::vector<E>                                            v(1000);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = t; i < 1000; i += 4) list.push_back(&v[i]);
+            });
+        }
+    }
+    EXPECT_EQ(list.size(), 1000);
+
+    const auto all = br::lock_profiles();
+    EXPECT_TRUE(std::any_of(all.begin(), all.end(), [](const auto& p) { return p.acquisitions >= 1000; }));
+    while (list.pop_front()) {}
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "rw_spinlock.h"
+
+TEST(RwSpinlockTest, TryLock)
+{
+    br::rw_spinlock l(4);
+
+    EXPECT_TRUE(l.try_lock_shared());
+    EXPECT_TRUE(l.try_lock_shared());
+    EXPECT_FALSE(l.try_lock());
+    l.unlock_shared();
+    l.unlock_shared();
+
+    EXPECT_TRUE(l.try_lock());
+    EXPECT_FALSE(l.try_lock());
+    EXPECT_FALSE(l.try_lock_shared());
+
+    bool other = true;
+    std::jthread([&]() { other = l.try_lock_shared(); }).join();
+    EXPECT_FALSE(other);
+
+    l.unlock();
+    EXPECT_TRUE(l.try_lock_shared());
+    l.unlock_shared();
+}
+
+TEST(RwSpinlockTest, ReadersSeeWholeWrites)
+{
+    br::rw_spinlock l;
+    long            a = 0;
+    long            b = 0;
+
+    std::atomic<bool> stop{false};
+    std::atomic<long> torn{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                while (!stop) {
+                    std::shared_lock g(l);
+                    if (a != b) ++torn;
+                }
+            });
+        }
+        for (int t = 0; t < 2; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 20000; ++i) {
+                    std::lock_guard g(l);
+                    a = a + 1;
+                    b = b + 1;
+                }
+            });
+        }
+        threads[4].join();
+        threads[5].join();
+        stop = true;
+    }
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(a, 40000);
+    EXPECT_EQ(b, 40000);
+}
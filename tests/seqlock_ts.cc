@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "seqlock.h"
+
+namespace {
+struct config {
+    int    version;
+    int    twice;
+    double third;
+    char   tag[12];
+};
+} // namespace
+
+TEST(SeqlockTest, Basic)
+{
+    br::seqlock<config> s({1, 2, 1 / 3.0, "one"});
+    EXPECT_EQ(s.version(), 0);
+    EXPECT_EQ(s.load().twice, 2);
+    EXPECT_STREQ(s.load().tag, "one");
+
+    s.store({2, 4, 2 / 3.0, "two"});
+    EXPECT_EQ(s.version(), 1);
+
+    const auto c = s.load();
+    EXPECT_EQ(c.version, 2);
+    EXPECT_EQ(c.twice, 4);
+    EXPECT_DOUBLE_EQ(c.third, 2 / 3.0);
+    EXPECT_STREQ(c.tag, "two");
+}
+
+TEST(SeqlockTest, ReadersNeverSeeTornValues)
+{
+    br::seqlock<config> s({0, 0, 0.0, ""});
+
+    std::atomic<bool> stop{false};
+    std::atomic<long> torn{0};
+    {
+        std::vector<std::jthread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&]() {
+                int last = 0;
+                while (!stop) {
+                    const auto c = s.load();
+                    if (c.twice != 2 * c.version || c.third != c.version / 3.0 || c.version < last) ++torn;
+                    last = c.version;
+                }
+            });
+        }
+
+        for (int i = 1; i <= 100000; ++i) s.store({i, 2 * i, i / 3.0, "x"});
+        stop = true;
+    }
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(s.version(), 100000);
+}
+
+TEST(SeqlockTest, NotDefaultConstructible)
+{
+    struct point {
+        point(int x, int y) : x(x), y(y) {}
+
+        int x;
+        int y;
+    };
+
+    br::seqlock<point> s(point(1, 2));
+    s.store(point(3, 4));
+    EXPECT_EQ(s.load().x, 3);
+    EXPECT_EQ(s.load().y, 4);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "sharded_timer_wheel.h"
+
+class ShardedTimerWheelTest: public testing::Test {
+protected:
+    ShardedTimerWheelTest()           = default;
+    ~ShardedTimerWheelTest() override = default;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    struct K final: br::expirable {
+        std::atomic<int>* fired{nullptr};
+        std::thread::id   on;
+        int               n{0};
+
+        void expire() override
+        {
+            on = std::this_thread::get_id();
+            ++n;
+            fired->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    using ms_sharded_timer_wheel = br::basic_sharded_timer_wheel<std::chrono::milliseconds>;
+
+    static bool wait_for(const std::atomic<int>& fired, int n)
+    {
+        const auto t = std::chrono::steady_clock::now();
+        while (fired.load(std::memory_order_acquire) < n) {
+            if (std::chrono::steady_clock::now() - t > std::chrono::seconds(10)) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+
+TEST_F(ShardedTimerWheelTest, Basic)
+{
+    ms_sharded_timer_wheel stw(std::chrono::milliseconds(1), 64, {0, 0, 0}, 16);
+    EXPECT_EQ(stw.size(), 3);
+
+    std::atomic<int> fired{0};
+    std::vector<K>   v(300);
+
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i].fired = &fired;
+        // The inboxes only hold 16 entries
+        while (!stw.publish(i % stw.size(), &v[i], now + std::chrono::milliseconds(i % 20))) {
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_TRUE(wait_for(fired, v.size()));
+
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i].n, 1);
+        // Fired on the thread of its shard, different from the other shards
+        EXPECT_EQ(v[i].on, v[i % stw.size()].on);
+        EXPECT_NE(v[i].on, v[(i + 1) % stw.size()].on);
+        EXPECT_NE(v[i].on, std::this_thread::get_id());
+    }
+}
+
+TEST_F(ShardedTimerWheelTest, Cancel)
+{
+    ms_sharded_timer_wheel stw(std::chrono::milliseconds(1), 64);
+
+    std::atomic<int> fired{0};
+    K                k;
+    K                l;
+    k.fired = &fired;
+    l.fired = &fired;
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto sk  = stw.local_shard();
+    EXPECT_LT(sk, stw.size());
+    EXPECT_TRUE(stw.publish(sk, &k, now + std::chrono::milliseconds(200)));
+    EXPECT_TRUE(stw.publish(stw.local_shard(), &l, now + std::chrono::milliseconds(50)));
+    EXPECT_TRUE(stw.cancel(sk, &k));
+
+    EXPECT_TRUE(wait_for(fired, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    EXPECT_EQ(k.n, 0);
+    EXPECT_EQ(l.n, 1);
+}
+
+TEST_F(ShardedTimerWheelTest, FullInbox)
+{
+    // A slot long enough for the shard to sleep while the inbox fills up
+    ms_sharded_timer_wheel stw(std::chrono::milliseconds(1000), 64, {0}, 4);
+
+    std::vector<K>   v(64);
+    std::atomic<int> fired{0};
+    const auto       now      = std::chrono::steady_clock::now();
+    std::size_t      rejected = 0;
+    for (auto& k : v) {
+        k.fired = &fired;
+        while (!stw.publish(0, &k, now)) {
+            ++rejected;
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_GT(rejected, 0);
+    EXPECT_TRUE(wait_for(fired, v.size()));
+}
+
+TEST_F(ShardedTimerWheelTest, DestroyAfterCancel)
+{
+    ms_sharded_timer_wheel stw(std::chrono::milliseconds(1), 64, {0, 0});
+
+    std::atomic<int> fired{0};
+    for (int i = 0; i < 200; ++i) {
+        auto k   = std::make_unique<K>();
+        k->fired = &fired;
+
+        // Due now or soon, so the cancel races with the expiration
+        const auto idx = static_cast<std::size_t>(i) % stw.size();
+        ASSERT_TRUE(stw.publish(idx, k.get(), std::chrono::steady_clock::now() + std::chrono::milliseconds(i % 3)));
+        if (i % 2) std::this_thread::sleep_for(std::chrono::microseconds(500));
+        stw.cancel_and_wait(idx, k.get());
+
+        EXPECT_FALSE(k->linked());
+        EXPECT_LE(k->n, 1);
+    }
+    EXPECT_LE(fired.load(), 200);
+}
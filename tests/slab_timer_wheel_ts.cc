@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "slab_timer_wheel.h"
+
+#include <random>
+
+class SlabTimerWheelTest: public testing::Test {
+protected:
+    const br::time_point t;
+};
+
+TEST_F(SlabTimerWheelTest, Basic)
+{
+    br::slab_timer_wheel tw(std::chrono::seconds(1), 100, t);
+
+    std::vector<std::uint64_t> fired;
+    auto                       collect = [&](std::uint64_t d) { fired.push_back(d); };
+
+    tw.publish(t + std::chrono::seconds(200), 1);
+    tw.publish(t + std::chrono::seconds(100), 2);
+    EXPECT_EQ(tw.size(), 2);
+
+    tw.check_expiration(t + std::chrono::seconds(99), collect);
+    EXPECT_TRUE(fired.empty());
+
+    tw.check_expiration(t + std::chrono::seconds(101), collect);
+    EXPECT_EQ(fired, std::vector<std::uint64_t>{2});
+
+    tw.check_expiration(t + std::chrono::seconds(201), collect);
+    EXPECT_EQ(fired, (std::vector<std::uint64_t>{2, 1}));
+    EXPECT_EQ(tw.size(), 0);
+    EXPECT_FALSE(tw.next_expiration());
+}
+
+TEST_F(SlabTimerWheelTest, Cancel)
+{
+    br::slab_timer_wheel tw(std::chrono::seconds(1), 16, t);
+
+    std::vector<std::uint64_t> fired;
+
+    const auto a = tw.publish(t + std::chrono::seconds(3), 1);
+    const auto b = tw.publish(t + std::chrono::seconds(3), 2);
+    const auto c = tw.publish(t + std::chrono::seconds(3), 3);
+
+    EXPECT_TRUE(tw.cancel(b));
+    EXPECT_FALSE(tw.cancel(b));
+    EXPECT_TRUE(tw.pending(a));
+
+    // A callback cancelling a timer due in the same batch
+    tw.check_expiration(t + std::chrono::seconds(4), [&](std::uint64_t d) {
+        fired.push_back(d);
+        tw.cancel(d == 1 ? c : a);
+    });
+    EXPECT_EQ(fired.size(), 1);
+    EXPECT_FALSE(tw.pending(a));
+    EXPECT_FALSE(tw.pending(c));
+
+    // The index is reused with a new generation
+    const auto d = tw.publish(t + std::chrono::seconds(5), 4);
+    EXPECT_NE(d, a);
+    EXPECT_FALSE(tw.cancel(a));
+    EXPECT_TRUE(tw.pending(d));
+}
+
+TEST_F(SlabTimerWheelTest, Random)
+{
+    br::time_point       now;
+    br::slab_timer_wheel tw(std::chrono::seconds(1), 64, now);
+
+    std::mt19937                    gen(1337);
+    std::uniform_int_distribution<> dist(1, 1000);
+
+    std::vector<int>                            deadline(10000);
+    std::vector<br::slab_timer_wheel::timer_id> ids(deadline.size());
+    for (std::size_t i = 0; i < deadline.size(); ++i) {
+        deadline[i] = dist(gen);
+        ids[i]      = tw.publish(now + std::chrono::seconds(deadline[i]), i);
+    }
+
+    // Cancel every tenth
+    for (std::size_t i = 0; i < ids.size(); i += 10) EXPECT_TRUE(tw.cancel(ids[i]));
+
+    std::vector<int> fired(deadline.size(), -1);
+    for (int s = 1; s <= 1001; ++s) {
+        now = br::time_point{} + std::chrono::seconds(s);
+        tw.check_expiration(now, [&](std::uint64_t d) { fired[d] = s; });
+    }
+
+    for (std::size_t i = 0; i < deadline.size(); ++i) {
+        EXPECT_EQ(fired[i], i % 10 ? deadline[i] + 1 : -1);
+    }
+    EXPECT_EQ(tw.size(), 0);
+}
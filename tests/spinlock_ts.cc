@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#include "ilist.h"
 #include "spinlock.h"
 
 class SpinLockTest: public testing::Test {
@@ -15,6 +18,20 @@ protected:
     {
     }
 
+    // Unprotected read-modify-write: only exact if the lock excludes
+    template <typename LOCK>
+    static void hammer(LOCK& l, long& counter, int n_threads, int n_iterations)
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < n_iterations; ++i) {
+                    std::lock_guard g(l);
+                    counter = counter + 1;
+                }
+            });
+        }
+    }
 };
 
 
@@ -35,3 +52,84 @@ TEST_F(SpinLockTest, Basic)
 
 
 }
+
+TEST_F(SpinLockTest, TryLock)
+{
+    br::spinlock sl;
+    EXPECT_TRUE(sl.try_lock());
+    EXPECT_FALSE(sl.try_lock());
+
+    bool other = true;
+    std::jthread([&]() { other = sl.try_lock(); }).join();
+    EXPECT_FALSE(other);
+
+    sl.unlock();
+    EXPECT_TRUE(sl.try_lock());
+    sl.unlock();
+}
+
+TEST_F(SpinLockTest, MutualExclusion)
+{
+    br::spinlock sl;
+    long         counter = 0;
+    hammer(sl, counter, 4, 100000);
+    EXPECT_EQ(counter, 400000);
+}
+
+TEST_F(SpinLockTest, AdaptiveTryLock)
+{
+    br::adaptive_mutex m;
+    EXPECT_TRUE(m.try_lock());
+    EXPECT_FALSE(m.try_lock());
+    m.unlock();
+    EXPECT_TRUE(m.try_lock());
+    m.unlock();
+}
+
+TEST_F(SpinLockTest, AdaptiveMutualExclusion)
+{
+    br::adaptive_mutex m;
+    long               counter = 0;
+    hammer(m, counter, 8, 50000);
+    EXPECT_EQ(counter, 400000);
+}
+
+TEST_F(SpinLockTest, AdaptiveParksAndWakes)
+{
+    br::adaptive_mutex m;
+    int                done = 0;
+
+    m.lock();
+    {
+        // Long enough for all of them to give up spinning and park
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                std::lock_guard g(m);
+                ++done;
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(done, 0);
+        m.unlock();
+    }
+    EXPECT_EQ(done, 4);
+}
+
+TEST_F(SpinLockTest, AsIlistLock)
+{
+    struct E final: br::ilist<E, br::adaptive_mutex>::node {};
+
+    br::ilist<E, br::adaptive_mutex> l;
+    std::vector<E>                   v(1000);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = t; i < 1000; i += 4) l.push_back(&v[i]);
+            });
+        }
+    }
+    EXPECT_EQ(l.size(), 1000);
+    while (l.pop_front()) {}
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "timer_wheel.h"
+#include "timer_awaitable.h"
+
+namespace {
+
+// Eagerly started coroutine, its frame is freed when it completes
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Operation completed from outside the wheel, reporting whether it was cancelled
+struct manual_op {
+    std::coroutine_handle<> h;
+    bool                    cancelled{false};
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> c) noexcept { h = c; }
+    bool await_resume() const noexcept { return !cancelled; }
+
+    void complete() { std::exchange(h, nullptr).resume(); }
+
+    void cancel()
+    {
+        cancelled = true;
+        complete();
+    }
+};
+
+} // namespace
+
+class TimerAwaitableTest: public testing::Test {
+protected:
+    const br::time_point t;
+    br::timer_wheel      tw{std::chrono::seconds(1), 16, t};
+};
+
+TEST_F(TimerAwaitableTest, SleepUntil)
+{
+    int step = 0;
+
+    auto co = [&]() -> task {
+        step = 1;
+        co_await br::sleep_until(tw, t + std::chrono::seconds(2));
+        step = 2;
+        co_await br::sleep_until(tw, t + std::chrono::seconds(40));
+        step = 3;
+    };
+    co();
+    EXPECT_EQ(step, 1);
+
+    tw.check_expiration(t + std::chrono::seconds(2));
+    EXPECT_EQ(step, 1);
+
+    tw.check_expiration(t + std::chrono::seconds(3));
+    EXPECT_EQ(step, 2);
+
+    tw.check_expiration(t + std::chrono::seconds(25));
+    EXPECT_EQ(step, 2);
+
+    tw.check_expiration(t + std::chrono::seconds(41));
+    EXPECT_EQ(step, 3);
+    EXPECT_FALSE(tw.next_expiration());
+}
+
+TEST_F(TimerAwaitableTest, CallbackEntries)
+{
+    using callback_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex,
+                                                       std::chrono::duration<uint64_t>,
+                                                       std::chrono::steady_clock,
+                                                       br::callback_expirable>;
+    callback_timer_wheel cw(std::chrono::seconds(1), 16, t);
+
+    bool done = false;
+    auto co   = [&]() -> task {
+        co_await br::sleep_until(cw, t + std::chrono::seconds(5));
+        done = true;
+    };
+    co();
+
+    cw.check_expiration(t + std::chrono::seconds(5));
+    EXPECT_FALSE(done);
+    cw.check_expiration(t + std::chrono::seconds(6));
+    EXPECT_TRUE(done);
+}
+
+TEST_F(TimerAwaitableTest, TimeoutExpires)
+{
+    manual_op op;
+    int       result = -1;
+
+    auto co = [&]() -> task {
+        result = co_await br::with_timeout(tw, op, t + std::chrono::seconds(3));
+    };
+    co();
+    EXPECT_EQ(result, -1);
+
+    tw.check_expiration(t + std::chrono::seconds(4));
+    EXPECT_TRUE(op.cancelled);
+    EXPECT_EQ(result, 0);
+}
+
+TEST_F(TimerAwaitableTest, CompletesFirst)
+{
+    manual_op op;
+    int       result = -1;
+
+    auto co = [&]() -> task {
+        result = co_await br::with_timeout(tw, op, t + std::chrono::seconds(3));
+    };
+    co();
+
+    op.complete();
+    EXPECT_EQ(result, 1);
+
+    // The timeout was taken out of the wheel
+    tw.check_expiration(t + std::chrono::seconds(4));
+    EXPECT_FALSE(op.cancelled);
+}
+
+TEST_F(TimerAwaitableTest, SleepWithTimeout)
+{
+    int step = 0;
+
+    auto co = [&]() -> task {
+        co_await br::with_timeout(tw, br::sleep_until(tw, t + std::chrono::seconds(10)), t + std::chrono::seconds(3));
+        step = 1;
+    };
+    co();
+
+    tw.check_expiration(t + std::chrono::seconds(4));
+    EXPECT_EQ(step, 1);
+
+    // The cancelled sleep was taken out of the wheel
+    tw.check_expiration(t + std::chrono::seconds(11));
+    EXPECT_EQ(step, 1);
+}
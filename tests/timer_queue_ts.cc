@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include "timer_queue.h"
+
+#include <random>
+
+class TimerQueueTest: public testing::Test {
+protected:
+    struct F final: br::expirable {
+        br::time_point   fired{};
+        br::time_point*  now{nullptr};
+        std::vector<F*>* order{nullptr};
+
+        void expire() override
+        {
+            fired = *now;
+            if (order) order->push_back(this);
+        }
+    };
+
+    br::time_point now;
+};
+
+TEST_F(TimerQueueTest, ExactDeadlines)
+{
+    br::timer_queue q;
+
+    F a;
+    F b;
+    a.now = b.now = &now;
+    q.publish(&a, now + std::chrono::microseconds(1500));
+    q.publish(&b, now + std::chrono::microseconds(700));
+
+    EXPECT_EQ(q.next_expiration(), now + std::chrono::microseconds(700));
+
+    q.check_expiration(now + std::chrono::microseconds(699));
+    EXPECT_EQ(q.size(), 2);
+
+    now += std::chrono::microseconds(700);
+    q.check_expiration(now);
+    EXPECT_EQ(b.fired, now);
+    EXPECT_TRUE(q.pending(&a));
+    EXPECT_FALSE(q.pending(&b));
+
+    now += std::chrono::microseconds(800);
+    q.check_expiration(now);
+    EXPECT_EQ(a.fired, now);
+    EXPECT_FALSE(q.next_expiration());
+}
+
+TEST_F(TimerQueueTest, Random)
+{
+    br::timer_queue q;
+
+    std::mt19937                    gen(1337);
+    std::uniform_int_distribution<> dist(0, 100000);
+
+    std::vector<F>  v(5000);
+    std::vector<F*> order;
+    for (auto& f : v) {
+        f.now   = &now;
+        f.order = &order;
+        q.publish(&f, now + std::chrono::microseconds(dist(gen)));
+    }
+
+    // Move some, cancel some
+    for (std::size_t i = 0; i < v.size(); i += 3) q.reschedule(&v[i], now + std::chrono::microseconds(dist(gen)));
+    for (std::size_t i = 1; i < v.size(); i += 7) EXPECT_TRUE(q.cancel(&v[i]));
+    EXPECT_FALSE(q.cancel(&v[1]));
+
+    while (const auto next = q.next_expiration()) {
+        now = *next;
+        q.check_expiration(now);
+    }
+
+    EXPECT_EQ(order.size(), v.size() - (v.size() + 5) / 7);
+    for (std::size_t i = 1; i < order.size(); ++i) {
+        EXPECT_LE(order[i - 1]->fired, order[i]->fired);
+    }
+}
+
+TEST_F(TimerQueueTest, Hybrid)
+{
+    br::basic_hybrid_timer_queue<br::detail_::void_mutex, std::chrono::milliseconds> q(
+        std::chrono::milliseconds(10), 256, now, std::chrono::milliseconds(50));
+
+    F precise;
+    F coarse;
+    F cancelled;
+    precise.now = coarse.now = cancelled.now = &now;
+
+    q.publish(&precise, now + std::chrono::microseconds(12345));
+    q.publish(&coarse, now + std::chrono::milliseconds(1003));
+    q.publish(&cancelled, now + std::chrono::milliseconds(2000));
+    EXPECT_TRUE(q.cancel(&cancelled));
+
+    EXPECT_EQ(q.next_expiration(), now + std::chrono::microseconds(12345));
+
+    while (const auto next = q.next_expiration()) {
+        now = *next;
+        q.check_expiration(now);
+    }
+
+    // Exact on the heap, end of the slot on the wheel
+    EXPECT_EQ(precise.fired, br::time_point{} + std::chrono::microseconds(12345));
+    EXPECT_EQ(coarse.fired, br::time_point{} + std::chrono::milliseconds(1010));
+    EXPECT_EQ(cancelled.fired, br::time_point{});
+}
+
+TEST_F(TimerQueueTest, HybridReschedule)
+{
+    br::basic_hybrid_timer_queue<br::detail_::void_mutex, std::chrono::milliseconds> q(
+        std::chrono::milliseconds(10), 256, now, std::chrono::milliseconds(50));
+
+    std::vector<F*> order;
+    F               to_wheel;
+    F               to_queue;
+    F               other;
+    to_wheel.now = to_queue.now = other.now = &now;
+    to_wheel.order = to_queue.order = other.order = &order;
+
+    // Queue to wheel, while other entries share the heap
+    q.publish(&to_wheel, now + std::chrono::microseconds(10000));
+    q.publish(&other, now + std::chrono::microseconds(20000));
+    q.publish(&to_wheel, now + std::chrono::milliseconds(1003));
+
+    // Wheel to queue
+    q.publish(&to_queue, now + std::chrono::milliseconds(2000));
+    q.reschedule(&to_queue, now + std::chrono::microseconds(30000));
+
+    while (const auto next = q.next_expiration()) {
+        now = *next;
+        q.check_expiration(now);
+    }
+
+    ASSERT_EQ(order.size(), 3);
+    EXPECT_EQ(order[0], &other);
+    EXPECT_EQ(order[1], &to_queue);
+    EXPECT_EQ(order[2], &to_wheel);
+    EXPECT_EQ(other.fired, br::time_point{} + std::chrono::microseconds(20000));
+    EXPECT_EQ(to_queue.fired, br::time_point{} + std::chrono::microseconds(30000));
+    EXPECT_EQ(to_wheel.fired, br::time_point{} + std::chrono::milliseconds(1010));
+}
+
+TEST_F(TimerQueueTest, RepublishWhileExpiring)
+{
+    struct R final: br::expirable {
+        br::timer_queue* q{nullptr};
+        br::time_point   at{};
+        int              n{0};
+
+        // Due again right away
+        void expire() override
+        {
+            ++n;
+            q->publish(this, at);
+        }
+    };
+
+    br::timer_queue q;
+
+    R r;
+    r.q  = &q;
+    r.at = now;
+    q.publish(&r, now);
+
+    q.check_expiration(now);
+    EXPECT_EQ(r.n, 1);
+    EXPECT_TRUE(q.pending(&r));
+
+    q.check_expiration(now);
+    EXPECT_EQ(r.n, 2);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "timer_wheel_driver.h"
+
+#if defined(__linux__)
+
+#include <sys/resource.h>
+
+class TimerWheelDriverTest: public testing::Test {
+protected:
+    TimerWheelDriverTest()           = default;
+    ~TimerWheelDriverTest() override = default;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    struct K final: br::ts_expirable {
+        std::atomic<std::chrono::steady_clock::time_point> fired{};
+
+        void expire() override
+        {
+            fired = std::chrono::steady_clock::now();
+        }
+    };
+
+    using ms_ts_timer_wheel = br::basic_timer_wheel<std::mutex, std::chrono::milliseconds>;
+
+    static std::chrono::microseconds cpu_time()
+    {
+        rusage ru{};
+        getrusage(RUSAGE_SELF, &ru);
+        return std::chrono::seconds(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+               std::chrono::microseconds(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+    }
+};
+
+
+TEST_F(TimerWheelDriverTest, NextExpiration)
+{
+    const br::time_point t;
+
+    br::timer_wheel tw(std::chrono::seconds(1), 16, t);
+    EXPECT_FALSE(tw.next_expiration());
+
+    struct L final: br::expirable {
+        void expire() override {}
+    } k, l;
+
+    tw.publish(&k, t + std::chrono::seconds(20));
+    EXPECT_EQ(tw.next_expiration(), t + std::chrono::seconds(5));
+
+    tw.publish(&l, t + std::chrono::seconds(3));
+    EXPECT_EQ(tw.next_expiration(), t + std::chrono::seconds(4));
+
+    tw.check_expiration(t + std::chrono::seconds(4));
+    EXPECT_EQ(tw.next_expiration(), t + std::chrono::seconds(5));
+
+    // Slot 4 only holds an entry of the next revolution
+    tw.check_expiration(t + std::chrono::seconds(5));
+    EXPECT_EQ(tw.next_expiration(), t + std::chrono::seconds(21));
+
+    tw.check_expiration(t + std::chrono::seconds(21));
+    EXPECT_FALSE(tw.next_expiration());
+}
+
+TEST_F(TimerWheelDriverTest, Driver)
+{
+    const auto        t = std::chrono::steady_clock::now();
+    ms_ts_timer_wheel tw(std::chrono::milliseconds(1), 256, t);
+
+    br::timer_wheel_driver<ms_ts_timer_wheel> driver(tw);
+
+    K k;
+    K l;
+
+    // A later timer first, then an earlier one that has to wake the driver up
+    driver.publish(&k, t + std::chrono::milliseconds(300));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    driver.publish(&l, t + std::chrono::milliseconds(100));
+
+    const auto cpu = cpu_time();
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+    const auto fk = k.fired.load();
+    const auto fl = l.fired.load();
+    EXPECT_GE(fl, t + std::chrono::milliseconds(100));
+    EXPECT_LT(fl, t + std::chrono::milliseconds(150));
+    EXPECT_GE(fk, t + std::chrono::milliseconds(300));
+    EXPECT_LT(fk, t + std::chrono::milliseconds(350));
+
+    // Sleeping most of the time
+    EXPECT_LT(cpu_time() - cpu, std::chrono::milliseconds(100));
+}
+
+#endif // __linux__
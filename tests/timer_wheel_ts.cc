@@ -1,6 +1,36 @@
 #include <gtest/gtest.h>
 
 #include "timer_wheel.h"
+#include "clock.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <thread>
+
+namespace {
+// The first lock() of a thread that set hold waits until the test opens the gate
+struct gated_mutex {
+    static inline thread_local bool hold{false};
+    static inline std::atomic<bool> arrived{false};
+    static inline std::atomic<bool> open{false};
+
+    void lock()
+    {
+        if (hold) {
+            hold = false;
+            arrived.store(true);
+            arrived.notify_one();
+            open.wait(false);
+        }
+        m.lock();
+    }
+
+    void unlock() { m.unlock(); }
+
+    std::mutex m;
+};
+} // namespace
 
 class TimerWheelTest: public testing::Test {
 protected:
@@ -76,3 +106,610 @@ TEST_F(TimerWheelTest, Basic)
     EXPECT_EQ(k.a, 1337);
     EXPECT_EQ(l.a, 1337);
 }
+
+TEST_F(TimerWheelTest, SubSecond)
+{
+    using us_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex, std::chrono::microseconds>;
+
+    const br::time_point t;
+
+    // 100us slots, 64 slots to exercise the power of two path
+    us_timer_wheel tw(std::chrono::microseconds(100), 64, t);
+
+    L k;
+    L l;
+
+    tw.publish(&k, t + std::chrono::microseconds(250));
+    tw.publish(&l, t + std::chrono::milliseconds(10));
+
+    tw.check_expiration(t + std::chrono::microseconds(299));
+    EXPECT_EQ(k.a, 0);
+
+    tw.check_expiration(t + std::chrono::microseconds(300));
+    EXPECT_EQ(k.a, 1337);
+    EXPECT_EQ(l.a, 0);
+
+    tw.check_expiration(t + std::chrono::microseconds(10099));
+    EXPECT_EQ(l.a, 0);
+
+    tw.check_expiration(t + std::chrono::microseconds(10100));
+    EXPECT_EQ(l.a, 1337);
+}
+
+TEST_F(TimerWheelTest, Clock)
+{
+    using tsc_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex, std::chrono::milliseconds, br::tsc_clock>;
+
+    const auto t = br::tsc_clock::now();
+
+    tsc_timer_wheel tw(std::chrono::milliseconds(1), 10, t);
+
+    L k;
+    tw.publish(&k, t + std::chrono::milliseconds(5));
+
+    tw.check_expiration(t + std::chrono::milliseconds(5));
+    EXPECT_EQ(k.a, 0);
+
+    tw.check_expiration(t + std::chrono::milliseconds(6));
+    EXPECT_EQ(k.a, 1337);
+}
+
+TEST_F(TimerWheelTest, Reschedule)
+{
+    const br::time_point t;
+
+    br::timer_wheel tw(std::chrono::seconds(1), 16, t);
+
+    L k;
+    L l;
+
+    tw.publish(&k, t + std::chrono::seconds(10));
+    tw.publish(&l, t + std::chrono::seconds(10));
+
+    tw.reschedule(&k, t + std::chrono::seconds(5));
+    tw.reschedule(&l, t + std::chrono::seconds(40));
+
+    tw.check_expiration(t + std::chrono::seconds(6));
+    EXPECT_EQ(k.a, 1337);
+    EXPECT_EQ(l.a, 0);
+
+    tw.check_expiration(t + std::chrono::seconds(40));
+    EXPECT_EQ(l.a, 0);
+
+    tw.check_expiration(t + std::chrono::seconds(41));
+    EXPECT_EQ(l.a, 1337);
+}
+
+TEST_F(TimerWheelTest, Touch)
+{
+    const br::time_point t;
+
+    br::ts_timer_wheel tw(std::chrono::seconds(1), 16, t);
+
+    K k;
+    tw.publish(&k, t + std::chrono::seconds(3));
+
+    // An idle timeout refreshed every second for a while, crossing several revolutions
+    auto now = t;
+    for (int i = 0; i < 50; ++i) {
+        now += std::chrono::seconds(1);
+        tw.check_expiration(now);
+        tw.touch(&k, now + std::chrono::seconds(3));
+    }
+    EXPECT_EQ(k.a, 0);
+
+    // An earlier deadline is not lazy
+    tw.touch(&k, now + std::chrono::seconds(1));
+
+    tw.check_expiration(now + std::chrono::seconds(1));
+    EXPECT_EQ(k.a, 0);
+
+    tw.check_expiration(now + std::chrono::seconds(2));
+    EXPECT_EQ(k.a, 1337);
+}
+
+TEST_F(TimerWheelTest, Periodic)
+{
+    struct P final: br::expirable {
+        br::timer_wheel* tw{nullptr};
+        br::time_point   next;
+        int              n{0};
+
+        void expire() override
+        {
+            ++n;
+            next += std::chrono::seconds(3);
+            tw->publish(this, next);
+        }
+    };
+
+    const br::time_point t;
+
+    br::timer_wheel tw(std::chrono::seconds(1), 4, t);
+
+    P p;
+    p.tw   = &tw;
+    p.next = t + std::chrono::seconds(3);
+    tw.publish(&p, p.next);
+
+    for (int s = 1; s <= 31; ++s) {
+        tw.check_expiration(t + std::chrono::seconds(s));
+    }
+    EXPECT_EQ(p.n, 10);
+}
+
+TEST_F(TimerWheelTest, CatchUp)
+{
+    const br::time_point t;
+
+    br::ts_timer_wheel tw(std::chrono::seconds(1), 100, t);
+
+    std::vector<K> v(300);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        tw.publish(&v[i], t + std::chrono::seconds(i * 10));
+    }
+
+    // Twenty revolutions in one call
+    tw.check_expiration(t + std::chrono::seconds(2000));
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i].a, i < 200 ? 1337 : 0) << i;
+    }
+
+    tw.check_expiration(t + std::chrono::seconds(2501));
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i].a, i <= 250 ? 1337 : 0) << i;
+    }
+
+    tw.check_expiration(t + std::chrono::seconds(5000));
+    for (const auto& k : v) {
+        EXPECT_EQ(k.a, 1337);
+    }
+}
+
+TEST_F(TimerWheelTest, Executor)
+{
+    const br::time_point t;
+
+    br::ts_timer_wheel tw(std::chrono::seconds(1), 16, t);
+
+    std::vector<K> v(10);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        tw.publish(&v[i], t + std::chrono::seconds(i));
+    }
+
+    // Deferred to a queue owned by the executor
+    br::basic_expirables_list<std::mutex> deferred;
+    std::size_t                           batches = 0;
+
+    tw.check_expiration(t + std::chrono::seconds(5), [&](br::basic_expirables_list<std::mutex>& batch) {
+        ++batches;
+        EXPECT_EQ(batch.size(), 5);
+        deferred.splice_if(batch, [](auto&) { return true; });
+    });
+
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(deferred.size(), 5);
+    for (const auto& k : v) {
+        EXPECT_EQ(k.a, 0);
+    }
+
+    while (auto* e = deferred.pop_front()) {
+        e->expire();
+    }
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i].a, i < 5 ? 1337 : 0);
+    }
+
+    // What is left in the batch is expired inline
+    tw.check_expiration(t + std::chrono::seconds(10), [](auto&) {});
+    for (const auto& k : v) {
+        EXPECT_EQ(k.a, 1337);
+    }
+}
+
+TEST_F(TimerWheelTest, Concurrent)
+{
+    struct C final: br::ts_expirable {
+        std::atomic<int>* fired{nullptr};
+        int               n{0};
+
+        void expire() override
+        {
+            ++n;
+            fired->fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    constexpr std::size_t n_threads = 4;
+    constexpr std::size_t n_timers  = 2000;
+
+    using ms_ts_timer_wheel = br::basic_timer_wheel<std::mutex, std::chrono::milliseconds>;
+
+    const auto        t = std::chrono::steady_clock::now();
+    ms_ts_timer_wheel tw(std::chrono::milliseconds(1), 64, t);
+
+    std::atomic<int>            fired{0};
+    std::vector<std::vector<C>> due(n_threads, std::vector<C>(n_timers));
+    std::vector<std::vector<C>> cancelled(n_threads, std::vector<C>(n_timers));
+
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 0; i < n_threads; ++i) {
+            workers.emplace_back([&, i]() {
+                for (std::size_t j = 0; j < n_timers; ++j) {
+                    due[i][j].fired       = &fired;
+                    cancelled[i][j].fired = &fired;
+
+                    const auto now = std::chrono::steady_clock::now();
+                    tw.publish(&due[i][j], now + std::chrono::milliseconds(j % 50));
+                    tw.publish(&cancelled[i][j], now + std::chrono::hours(1));
+                    cancelled[i][j].unlink();
+                }
+            });
+        }
+
+        while (fired.load() < static_cast<int>(n_threads * n_timers) &&
+               std::chrono::steady_clock::now() - t < std::chrono::seconds(30)) {
+            tw.check_expiration(std::chrono::steady_clock::now());
+        }
+    }
+
+    EXPECT_EQ(fired.load(), n_threads * n_timers);
+    for (std::size_t i = 0; i < n_threads; ++i) {
+        for (std::size_t j = 0; j < n_timers; ++j) {
+            EXPECT_EQ(due[i][j].n, 1);
+            EXPECT_EQ(cancelled[i][j].n, 0);
+        }
+    }
+}
+
+TEST_F(TimerWheelTest, CancelWhileExpiring)
+{
+    struct C final: br::ts_expirable {
+        std::atomic<int> n{0};
+
+        void expire() override { n.fetch_add(1, std::memory_order_relaxed); }
+    };
+
+    constexpr std::size_t n_timers = 2000;
+    constexpr int         n_rounds = 20;
+
+    using ms_ts_timer_wheel = br::basic_timer_wheel<std::mutex, std::chrono::milliseconds>;
+
+    const auto        t = std::chrono::steady_clock::now();
+    ms_ts_timer_wheel tw(std::chrono::milliseconds(1), 64, t);
+
+    for (int r = 0; r < n_rounds; ++r) {
+        std::vector<C> entries(n_timers);
+        for (std::size_t j = 0; j < n_timers; ++j) {
+            tw.publish(&entries[j], t + std::chrono::milliseconds(r * 100 + static_cast<int>(j % 50)));
+        }
+
+        {
+            // Cancels every entry while they are spliced from their slots into the batch
+            std::jthread canceller([&]() {
+                for (auto& e : entries) {
+                    e.unlink();
+                    if ((&e - entries.data()) % 64 == 0) std::this_thread::yield();
+                }
+            });
+
+            tw.check_expiration(t + std::chrono::milliseconds(r * 100 + 100), [](auto&) { std::this_thread::yield(); });
+        }
+
+        for (const auto& e : entries) {
+            EXPECT_FALSE(e.linked());
+            EXPECT_LE(e.n.load(), 1);
+        }
+        EXPECT_FALSE(tw.next_expiration());
+    }
+}
+
+TEST_F(TimerWheelTest, PublishRacingWithExpiration)
+{
+    struct C final: br::basic_timer_entry<C, gated_mutex> {
+        int n{0};
+
+        void expire() { ++n; }
+    };
+
+    using gated_timer_wheel = br::basic_timer_wheel<gated_mutex, std::chrono::milliseconds, std::chrono::steady_clock, C>;
+
+    const auto        t = std::chrono::steady_clock::now();
+    gated_timer_wheel tw(std::chrono::milliseconds(1), 64, t);
+    C                 e;
+
+    std::jthread publisher([&]() {
+        gated_mutex::hold = true;
+        tw.publish(&e, t);
+    });
+
+    // The publisher saw tick 0 and is about to link the entry into slot 0, which the
+    // wheel sweeps now
+    gated_mutex::arrived.wait(false);
+    tw.check_expiration(t + std::chrono::milliseconds(1));
+    gated_mutex::open.store(true);
+    gated_mutex::open.notify_one();
+    publisher.join();
+
+    EXPECT_EQ(e.n, 0);
+    tw.check_expiration(t + std::chrono::milliseconds(2));
+    EXPECT_EQ(e.n, 1);
+}
+
+TEST_F(TimerWheelTest, SnapshotStatsAndFailures)
+{
+    using stats_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex,
+                                                    std::chrono::duration<uint64_t>,
+                                                    std::chrono::steady_clock,
+                                                    br::expirable,
+                                                    br::timer_wheel_stats>;
+
+    const auto path = std::filesystem::temp_directory_path() / "br_timer_wheel_snapshot_stats";
+    auto       tmp  = path;
+    tmp += ".tmp";
+
+    const br::time_point t;
+    std::vector<L>       v(3);
+    {
+        stats_timer_wheel tw(std::chrono::seconds(1), 64, t);
+        for (std::size_t i = 0; i < v.size(); ++i) tw.publish(&v[i], t + std::chrono::seconds(10 + i));
+        tw.save(path, t, [&](const br::expirable& e) { return static_cast<std::uint64_t>(static_cast<const L*>(&e) - v.data()); });
+        for (auto& l : v) l.unlink();
+    }
+
+    // Restored entries count as published
+    stats_timer_wheel tw(std::chrono::seconds(1), 64, t);
+    EXPECT_EQ(tw.load(path, t, [&](std::uint64_t key) { return &v[key]; }), v.size());
+    EXPECT_EQ(tw.stats().snapshot().published, v.size());
+    std::filesystem::remove(path);
+
+    // The snapshot cannot replace a directory, and the temporary file goes away
+    std::filesystem::create_directory(path);
+    std::ofstream(path / "keep") << "x";
+    EXPECT_THROW(tw.save(path, t, [](const br::expirable&) { return std::uint64_t{0}; }), std::system_error);
+    EXPECT_FALSE(std::filesystem::exists(tmp));
+    std::filesystem::remove_all(path);
+}
+
+TEST_F(TimerWheelTest, StaticEntry)
+{
+    struct S final: br::basic_timer_entry<S> {
+        int a{0};
+
+        void expire() { a = 1337; }
+    };
+
+    // No vtable pointer, neither from the entry nor from its list hook
+    static_assert(!std::is_polymorphic_v<S>);
+    static_assert(sizeof(S) < sizeof(L));
+
+    using static_timer_wheel =
+        br::basic_timer_wheel<br::detail_::void_mutex, std::chrono::duration<uint64_t>, std::chrono::steady_clock, S>;
+
+    const br::time_point t;
+    static_timer_wheel   tw(std::chrono::seconds(1), 16, t);
+
+    S k;
+    S l;
+    tw.publish(&k, t + std::chrono::seconds(2));
+    tw.publish(&l, t + std::chrono::seconds(40));
+
+    tw.check_expiration(t + std::chrono::seconds(3));
+    EXPECT_EQ(k.a, 1337);
+    EXPECT_EQ(l.a, 0);
+
+    tw.check_expiration(t + std::chrono::seconds(41));
+    EXPECT_EQ(l.a, 1337);
+}
+
+TEST_F(TimerWheelTest, CallbackEntry)
+{
+    using callback_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex,
+                                                       std::chrono::duration<uint64_t>,
+                                                       std::chrono::steady_clock,
+                                                       br::callback_expirable>;
+
+    static_assert(!std::is_polymorphic_v<br::callback_expirable>);
+
+    const br::time_point t;
+    callback_timer_wheel tw(std::chrono::seconds(1), 16, t);
+
+    int  a = 0;
+    int  b = 0;
+    br::callback_expirable k([&a]() { a = 1337; });
+    br::callback_expirable l([&a, &b]() { b = a + 1; });
+
+    tw.publish(&k, t + std::chrono::seconds(2));
+    tw.publish(&l, t + std::chrono::seconds(3));
+
+    tw.check_expiration(t + std::chrono::seconds(4));
+    EXPECT_EQ(a, 1337);
+    EXPECT_EQ(b, 1338);
+}
+
+TEST_F(TimerWheelTest, Stats)
+{
+    using stats_timer_wheel = br::basic_timer_wheel<br::detail_::void_mutex,
+                                                    std::chrono::duration<uint64_t>,
+                                                    std::chrono::steady_clock,
+                                                    br::expirable,
+                                                    br::timer_wheel_stats>;
+
+    static_assert(sizeof(br::timer_wheel) < sizeof(stats_timer_wheel));
+
+    const br::time_point t;
+    stats_timer_wheel    tw(std::chrono::seconds(1), 8, t);
+
+    L k;
+    L l;
+    L m;
+    tw.publish(&k, t + std::chrono::seconds(2));
+    tw.publish(&l, t + std::chrono::seconds(2));
+    tw.publish(&m, t + std::chrono::seconds(10)); // Same slot, next revolution
+
+    tw.check_expiration(t + std::chrono::seconds(5));
+
+    const auto s = tw.stats().snapshot();
+    EXPECT_EQ(s.published, 3);
+    EXPECT_EQ(s.expired, 2);
+    EXPECT_EQ(s.slots_visited, 1);
+    EXPECT_EQ(s.entries_skipped, 1);
+    EXPECT_EQ(s.slot_occupancy.count(), 1);
+    EXPECT_EQ(s.slot_occupancy.max(), 3);
+    EXPECT_EQ(s.callback_time.count(), 2);
+
+    // Slot [2, 3) checked at 5: two seconds late
+    EXPECT_EQ(s.lateness.count(), 2);
+    EXPECT_EQ(s.lateness.mean(), 2e9);
+    EXPECT_GE(s.lateness.percentile(0.5), 2000000000u);
+
+    tw.stats().reset();
+    m.unlink();
+    EXPECT_EQ(tw.stats().snapshot().published, 0);
+}
+
+TEST_F(TimerWheelTest, Slack)
+{
+    struct F final: br::expirable {
+        std::chrono::seconds deadline{0};
+        std::chrono::seconds fired{-1};
+        br::time_point*      now{nullptr};
+
+        void expire() override { fired = std::chrono::duration_cast<std::chrono::seconds>(now->time_since_epoch()); }
+    };
+
+    br::time_point  now;
+    br::timer_wheel tw(std::chrono::seconds(1), 256, now);
+
+    constexpr auto slack = std::chrono::seconds(16);
+
+    std::vector<F> v(1000);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i].deadline = std::chrono::seconds(1 + i % 200);
+        v[i].now      = &now;
+        tw.publish(&v[i], now + v[i].deadline, slack);
+    }
+
+    std::set<std::chrono::seconds::rep> ticks;
+    for (int s = 1; s <= 250; ++s) {
+        now = br::time_point{} + std::chrono::seconds(s);
+        tw.check_expiration(now);
+    }
+
+    for (const auto& f : v) {
+        EXPECT_GT(f.fired, f.deadline);
+        EXPECT_LE(f.fired, f.deadline + slack + std::chrono::seconds(1));
+        ticks.insert(f.fired.count());
+    }
+
+    // 200 different deadlines, coalesced on 16 seconds boundaries
+    EXPECT_LE(ticks.size(), 200u / 16 + 2);
+}
+
+TEST_F(TimerWheelTest, NegativeSlack)
+{
+    struct F final: br::expirable {
+        int a{0};
+
+        void expire() override { a = 1337; }
+    };
+
+    const br::time_point t;
+    br::timer_wheel      tw(std::chrono::seconds(1), 64, t);
+
+    // Fires on its deadline, as with no slack
+    F f;
+    tw.publish(&f, t + std::chrono::seconds(5), std::chrono::seconds(-3));
+    EXPECT_EQ(tw.next_expiration(), t + std::chrono::seconds(6));
+
+    tw.check_expiration(t + std::chrono::seconds(5));
+    EXPECT_EQ(f.a, 0);
+    tw.check_expiration(t + std::chrono::seconds(6));
+    EXPECT_EQ(f.a, 1337);
+}
+
+TEST_F(TimerWheelTest, Snapshot)
+{
+    struct S final: br::expirable {
+        std::uint64_t key{0};
+        int           a{0};
+
+        void expire() override { a = 1337; }
+    };
+
+    const auto path = std::filesystem::temp_directory_path() / "br_timer_wheel_snapshot";
+
+    std::vector<S> before(1000);
+    {
+        const br::time_point t;
+        br::timer_wheel      tw(std::chrono::seconds(1), 64, t);
+        for (std::size_t i = 0; i < before.size(); ++i) {
+            before[i].key = i;
+            tw.publish(&before[i], t + std::chrono::seconds(10 + i));
+        }
+
+        // Saved 5 seconds in, the first one has 5 seconds left
+        tw.check_expiration(t + std::chrono::seconds(5));
+        tw.save(path, t + std::chrono::seconds(5), [](const br::expirable& e) { return static_cast<const S&>(e).key; });
+        for (auto& s : before) s.unlink();
+    }
+
+    // Reloaded in a wheel started at another time, dropping the odd keys
+    const br::time_point t2 = br::time_point{} + std::chrono::hours(1);
+    br::timer_wheel      tw(std::chrono::seconds(1), 64, t2);
+    std::vector<S>       after(before.size());
+
+    const auto n = tw.load(path, t2, [&](std::uint64_t key) { return key % 2 ? nullptr : &after[key]; });
+    EXPECT_EQ(n, after.size() / 2);
+
+    tw.check_expiration(t2 + std::chrono::seconds(5));
+    EXPECT_EQ(after[0].a, 0);
+    tw.check_expiration(t2 + std::chrono::seconds(6));
+    EXPECT_EQ(after[0].a, 1337);
+    EXPECT_EQ(after[2].a, 0);
+
+    tw.check_expiration(t2 + std::chrono::seconds(2000));
+    for (std::size_t i = 0; i < after.size(); ++i) EXPECT_EQ(after[i].a, i % 2 ? 0 : 1337);
+
+    std::filesystem::remove(path);
+    EXPECT_THROW(tw.load(path, t2, [](std::uint64_t) { return nullptr; }), std::system_error);
+}
+
+TEST_F(TimerWheelTest, SnapshotSkipsPendingEntries)
+{
+    const auto path = std::filesystem::temp_directory_path() / "br_timer_wheel_snapshot_pending";
+
+    const br::time_point t;
+    std::vector<K>       saved(3);
+    {
+        br::ts_timer_wheel tw(std::chrono::seconds(1), 64, t);
+        for (std::size_t i = 0; i < saved.size(); ++i) tw.publish(&saved[i], t + std::chrono::seconds(10 + i));
+        tw.save(path, t, [](const br::ts_expirable&) { return std::uint64_t{0}; });
+        for (auto& k : saved) k.unlink();
+    }
+
+    // Every key resolves to the same entry, which is already pending for 30 seconds
+    br::ts_timer_wheel tw(std::chrono::seconds(1), 64, t);
+    K               k;
+    tw.publish(&k, t + std::chrono::seconds(30));
+
+    EXPECT_EQ(tw.load(path, t, [&](std::uint64_t) { return &k; }), 0);
+    EXPECT_EQ(tw.next_expiration(), t + std::chrono::seconds(31));
+
+    tw.check_expiration(t + std::chrono::seconds(30));
+    EXPECT_EQ(k.a, 0);
+    tw.check_expiration(t + std::chrono::seconds(31));
+    EXPECT_EQ(k.a, 1337);
+
+    // Not pending anymore: loaded once, at the first deadline saved for it
+    k.a = 0;
+    const br::time_point t2 = t + std::chrono::seconds(31);
+    EXPECT_EQ(tw.load(path, t2, [&](std::uint64_t) { return &k; }), 1);
+    tw.check_expiration(t2 + std::chrono::seconds(10));
+    EXPECT_EQ(k.a, 0);
+    tw.check_expiration(t2 + std::chrono::seconds(11));
+    EXPECT_EQ(k.a, 1337);
+
+    std::filesystem::remove(path);
+}